@@ -0,0 +1,95 @@
+#include "RPNCalc.h"
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			runBatch(CBlockReader& reader, ostream& ostr,
+	//						CResultSink* sink)
+	//	Description:	Runs a piped workload.  Each input line may hold any
+	//						number of whitespace-separated tokens; every
+	//						token is compiled straight out of the reader's
+	//						block buffer and executed, and once the line is
+	//						done its result (the top of the stack) is written
+	//						to ostr on a line of its own.  There is no
+	//						screen, no undo history and no per-line copy.
+	//						Commands that would prompt on cin are errors
+	//						here, and X ends the run.  Given a sink, each
+	//						line's result row (top, registers, error flag)
+	//						goes there instead of being printed.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		CBlockReader& reader -- the input (stdin or a file)
+	//					ostream& ostr -- where results go
+	//					CResultSink* sink -- binary result file, or null
+	//	Returns:		None
+	//	Called by:		main()
+	//	Calls:			CBlockReader::nextLine(); reloadIfChanged();
+	//						compileLine(); execute()
+	//	Input:			The workload, from reader.
+	//	Output:			One result per non-blank line: the top of the
+	//						stack, "(empty)" or the error marker; or one row per
+	//						line in sink.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, adding the
+	//									result sink.
+	//					10/19/2026	DL completed version 1.2, reloading a
+	//									watched program before each line.
+	//------------------------------------------------------------------------
+	void CRPNCalc::runBatch(CBlockReader& reader, ostream& ostr,
+		CResultSink* sink)
+	{
+		const char* line;
+		size_t len;
+
+		m_on = ON;
+		while (m_on && reader.nextLine(line, len))
+		{
+			reloadIfChanged();
+			const char* end = line + len;
+			const char* scan = line;
+			bool hadToken = false;
+			while (m_on)
+			{
+				while (scan < end && isspace(static_cast<unsigned char>(*scan)))
+					scan++;
+				if (scan == end)
+					break;
+				const char* token = scan;
+				while (scan < end
+					&& !isspace(static_cast<unsigned char>(*scan)))
+					scan++;
+				hadToken = true;
+				Instr instr = compileLine(token, scan - token, -1);
+				if (instr.op == EXIT)
+					m_on = OFF;
+				else if (instr.op == NOVAL
+					|| promptsUser(static_cast<cmd>(instr.op)))
+					m_error = true;
+				else
+					execute(instr);
+			}
+			if (!hadToken)
+				continue;
+			if (sink)
+			{
+				double registers[NUMREGS];
+				registerValues(registers);
+				sink->append(m_stack.empty() ? NAN : m_stack.front(),
+					registers, m_error);
+			}
+			else if (m_error)
+				ostr << errorMarker() << '\n';
+			else if (m_stack.empty())
+				ostr << "(empty)" << '\n';
+			else
+			{
+				printValue(ostr, m_stack.front());
+				ostr << '\n';
+			}
+			m_error = false;
+			m_limits.clearHit();
+		}
+		ostr.flush();
+	}
+} // end namespace TPUS_CALC
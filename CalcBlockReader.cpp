@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------
+//    Class:		CBlockReader
+//
+//    File:       CalcBlockReader.cpp
+//
+//    Description: This file contains the function definitions for
+//					CBlockReader
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcBlockReader.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#define read _read
+#define open _open
+#define close _close
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CBlockReader(int fd)
+	//	Description:	Reads from an already open descriptor (0 for stdin),
+	//						which is left open afterwards.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CBlockReader::CBlockReader(int fd) : m_fd(fd), m_owned(false),
+		m_buffer(BLOCK_SIZE), m_begin(0), m_end(0), m_eof(false)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			CBlockReader(const char* fileName)
+	//	Description:	Opens fileName for reading; check isOpen().
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CBlockReader::CBlockReader(const char* fileName) : m_fd(-1),
+		m_owned(true), m_buffer(BLOCK_SIZE), m_begin(0), m_end(0),
+		m_eof(false)
+	{
+#ifdef _WIN32
+		m_fd = open(fileName, _O_RDONLY | _O_BINARY);
+#else
+		m_fd = open(fileName, O_RDONLY);
+#endif
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			~CBlockReader()
+	//	Description:	Closes the file if this reader opened it.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CBlockReader::~CBlockReader()
+	{
+		if (m_owned && m_fd >= 0)
+			close(m_fd);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			nextLine(const char*& text, size_t& len)
+	//	Description:	Finds the next line.  text points into the reader's
+	//						buffer and stays valid until the next call; the
+	//						'\n' (and a '\r' before it) is not included.  A
+	//						last line without a '\n' is still returned.
+	//	Programmers:	David Landry
+	//	Parameters:		const char*& text -- receives the start of the line
+	//					size_t& len -- receives its length
+	//	Returns:		bool -- false once the input is used up
+	//	Called by:		CRPNCalc::runBatch()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CBlockReader::nextLine(const char*& text, size_t& len)
+	{
+		size_t scanned = m_begin;
+		for (;;)
+		{
+			const char* found = static_cast<const char*>(memchr(
+				&m_buffer[0] + scanned, '\n', m_end - scanned));
+			if (found)
+			{
+				text = &m_buffer[m_begin];
+				len = found - text;
+				m_begin += len + 1;
+				break;
+			}
+			scanned = m_end - m_begin;	// already searched, after refill()
+			if (!refill())
+			{
+				if (m_begin == m_end)
+					return false;
+				text = &m_buffer[m_begin];
+				len = m_end - m_begin;
+				m_begin = m_end;
+				break;
+			}
+			scanned += m_begin;
+		}
+		if (len > 0 && text[len - 1] == '\r')
+			len--;
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			refill()
+	//	Description:	Moves the unread tail of the buffer to the front and
+	//						reads the next block behind it, doubling the
+	//						buffer first if the tail already fills it.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- false at end of input or on a read error
+	//	Called by:		nextLine()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CBlockReader::refill()
+	{
+		if (m_eof || m_fd < 0)
+			return false;
+		if (m_begin > 0)
+		{
+			memmove(&m_buffer[0], &m_buffer[m_begin], m_end - m_begin);
+			m_end -= m_begin;
+			m_begin = 0;
+		}
+		if (m_end == m_buffer.size())
+			m_buffer.resize(m_buffer.size() * 2);
+		long got;
+		do
+			got = static_cast<long>(read(m_fd, &m_buffer[m_end],
+				static_cast<unsigned>(m_buffer.size() - m_end)));
+		while (got < 0 && errno == EINTR);
+		if (got <= 0)
+		{
+			m_eof = true;
+			return false;
+		}
+		m_end += got;
+		return true;
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,81 @@
+//----------------------------------------------------------------------------
+//    File:		CalcBlockReader.h
+//
+//    Class:	CBlockReader
+//----------------------------------------------------------------------------
+#ifndef CALCBLOCKREADER_H
+#define CALCBLOCKREADER_H
+
+#include <cstddef>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		CBlockReader Class
+//
+//    Description:	Reads a file descriptor (stdin or an opened file) in
+//						large blocks with read(2) and hands out lines as
+//						pointers into its own buffer, so no line is ever
+//						copied into a string.  A line that straddles two
+//						blocks is moved to the front of the buffer before
+//						the next block is read behind it; the buffer grows
+//						only for a line longer than a whole block.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  class CBlockReader:
+//
+//	  Properties:
+//		int m_fd -- the descriptor being read
+//		bool m_owned -- close m_fd on destruction
+//		vector<char> m_buffer -- the current block(s)
+//		size_t m_begin -- start of the unread data in m_buffer
+//		size_t m_end -- end of the valid data in m_buffer
+//		bool m_eof -- read(2) has reported end of input
+//
+//	  Methods:
+//
+//		inline:
+//			bool isOpen() const
+//
+//		non-inline:
+//			CBlockReader(int fd);
+//			CBlockReader(const char* fileName);
+//			~CBlockReader();
+//			bool nextLine(const char*& text, size_t& len);
+//		private:
+//			bool refill();
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	class CBlockReader
+	{
+	public:
+		static const size_t BLOCK_SIZE = 1 << 16;
+
+		explicit CBlockReader(int fd);
+		explicit CBlockReader(const char* fileName);
+		~CBlockReader();
+		bool nextLine(const char*& text, size_t& len);
+		bool isOpen() const { return m_fd >= 0; }
+
+	private:
+		CBlockReader(const CBlockReader&);				// not copyable
+		CBlockReader& operator=(const CBlockReader&);
+		bool refill();
+
+		int m_fd;
+		bool m_owned;
+		std::vector<char> m_buffer;
+		size_t m_begin;
+		size_t m_end;
+		bool m_eof;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,158 @@
+//----------------------------------------------------------------------------
+//    Class:		CComplexTable
+//
+//    File:       CalcComplex.cpp
+//
+//    Description: This file contains the complex kernels and the function
+//					definitions for CComplexTable
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcComplex.h"
+#include <cmath>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Function:		complexMultiply(ar, ai, br, bi, cr, ci, n)
+	//	Description:	c[k] = a[k] * b[k] for n split complex values.  The
+	//						loop body has no branches and no dependency
+	//						between iterations, so it is vectorized.  c may
+	//						be a or b.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void complexMultiply(const double* ar, const double* ai,
+		const double* br, const double* bi, double* cr, double* ci, size_t n)
+	{
+		for (size_t k = 0; k < n; k++)
+		{
+			double re = ar[k] * br[k] - ai[k] * bi[k];
+			double im = ar[k] * bi[k] + ai[k] * br[k];
+			cr[k] = re;
+			ci[k] = im;
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Function:		complexDivide(ar, ai, br, bi, cr, ci, n)
+	//	Description:	c[k] = a[k] / b[k] for n split complex values.  The
+	//						divisor is scaled by the larger of its parts
+	//						first so |b|^2 cannot overflow or underflow;
+	//						the scale is chosen with fmax rather than a
+	//						branch so the loop still vectorizes.  c may be
+	//						a or b.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void complexDivide(const double* ar, const double* ai,
+		const double* br, const double* bi, double* cr, double* ci, size_t n)
+	{
+		for (size_t k = 0; k < n; k++)
+		{
+			double scale = 1.0 / fmax(fabs(br[k]), fabs(bi[k]));
+			double sr = br[k] * scale;
+			double si = bi[k] * scale;
+			double inverse = scale / (sr * sr + si * si);
+			double re = (ar[k] * sr + ai[k] * si) * inverse;
+			double im = (ai[k] * sr - ar[k] * si) * inverse;
+			cr[k] = re;
+			ci[k] = im;
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			CComplexTable()
+	//	Description:	Creates an empty table.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CComplexTable::CComplexTable() : m_liveCount(0)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			add(double re, double im)
+	//	Description:	Stores a new complex value.
+	//	Programmers:	David Landry
+	//	Returns:		double -- the boxed handle to push
+	//	Called by:		CRPNCalc::pushComplex()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	double CComplexTable::add(double re, double im)
+	{
+		uint32_t index;
+		if (m_free.empty())
+		{
+			index = static_cast<uint32_t>(m_re.size());
+			m_re.push_back(re);
+			m_im.push_back(im);
+			m_live.push_back(false);
+			m_marked.push_back(false);
+		}
+		else
+		{
+			index = m_free.back();
+			m_free.pop_back();
+			m_re[index] = re;
+			m_im[index] = im;
+		}
+		m_live[index] = true;
+		m_liveCount++;
+		return box(BOX_COMPLEX, index);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			get(double value, double& re, double& im)
+	//	Description:	Looks up the complex value a stack value refers to.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- false if value is not a complex value
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CComplexTable::get(double value, double& re, double& im) const
+	{
+		if (!isBoxed(value) || boxKind(value) != BOX_COMPLEX)
+			return false;
+		uint32_t index = boxIndex(value);
+		if (index >= m_re.size() || !m_live[index])
+			return false;
+		re = m_re[index];
+		im = m_im[index];
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Methods:		mark(double value), sweep()
+	//	Description:	Garbage collection, as in CMatrixTable.
+	//	Programmers:	David Landry
+	//	Called by:		CRPNCalc::collectValues()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CComplexTable::mark(double value)
+	{
+		double re, im;
+		if (get(value, re, im))
+			m_marked[boxIndex(value)] = true;
+	}
+
+	void CComplexTable::sweep()
+	{
+		for (uint32_t i = 0; i < m_re.size(); i++)
+		{
+			if (m_live[i] && !m_marked[i])
+			{
+				m_live[i] = false;
+				m_liveCount--;
+				m_free.push_back(i);
+			}
+			m_marked[i] = false;
+		}
+	}
+} // end namespace TPUS_CALC
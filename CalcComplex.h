@@ -0,0 +1,97 @@
+//----------------------------------------------------------------------------
+//    File:		CalcComplex.h
+//
+//    Class:	CComplexTable
+//----------------------------------------------------------------------------
+#ifndef CALCCOMPLEX_H
+#define CALCCOMPLEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CalcMatrix.h"
+//----------------------------------------------------------------------------
+//
+//    Title:		Complex values
+//
+//    Description:	A complex stack value is a boxed handle of kind
+//						BOX_COMPLEX (see CalcMatrix.h) into a CComplexTable.
+//						The table keeps the real and imaginary parts in
+//						two separate arrays, and the kernels below take
+//						split arrays too, so a loop over n values runs
+//						the same multiply or divide in every lane with no
+//						shuffling of interleaved pairs.  Unreferenced
+//						values are freed by mark and sweep, as matrices
+//						are.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  class CComplexTable:
+//
+//	  Properties:
+//		vector<double> m_re -- real parts by index
+//		vector<double> m_im -- imaginary parts by index
+//		vector<bool> m_live -- index is in use
+//		vector<bool> m_marked -- reached during a collection
+//		vector<uint32_t> m_free -- indexes free for reuse
+//		size_t m_liveCount -- indexes in use
+//
+//	  Methods:
+//
+//		inline:
+//			size_t liveCount() const
+//			uint32_t slots() const
+//
+//		non-inline:
+//			CComplexTable();
+//			double add(double re, double im);
+//			bool get(double value, double& re, double& im) const;
+//			void mark(double value);
+//			void sweep();
+//
+//	  Functions:
+//		void complexMultiply(const double* ar, const double* ai,
+//			const double* br, const double* bi, double* cr, double* ci,
+//			size_t n) -- c = a * b
+//		void complexDivide(const double* ar, const double* ai,
+//			const double* br, const double* bi, double* cr, double* ci,
+//			size_t n) -- c = a / b
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	const uint32_t BOX_COMPLEX = 2;
+
+	void complexMultiply(const double* ar, const double* ai,
+		const double* br, const double* bi, double* cr, double* ci, size_t n);
+	void complexDivide(const double* ar, const double* ai,
+		const double* br, const double* bi, double* cr, double* ci, size_t n);
+
+	class CComplexTable
+	{
+	public:
+		CComplexTable();
+		double add(double re, double im);
+		bool get(double value, double& re, double& im) const;
+		void mark(double value);
+		void sweep();
+		size_t liveCount() const { return m_liveCount; }
+		uint32_t slots() const
+			{ return static_cast<uint32_t>(m_re.size()); }
+
+	private:
+		std::vector<double> m_re;
+		std::vector<double> m_im;
+		std::vector<bool> m_live;
+		std::vector<bool> m_marked;
+		std::vector<uint32_t> m_free;
+		size_t m_liveCount;
+	};
+} // end namespace TPUS_CALC
+
+#endif
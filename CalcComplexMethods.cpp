@@ -0,0 +1,264 @@
+#include "RPNCalc.h"
+#include <complex>
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			makeComplex()
+	//	Description:	J: pops the imaginary part and then the real part
+	//						and pushes re + im i, so "3 4 J" is 3+4i.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			binary_prep(); pushComplex()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::makeComplex()
+	{
+		double re = 0;
+		double im = 0;
+		binary_prep(im, re);
+		if (m_error == false)
+			pushComplex(re, im);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			complexPart(cmd thecmd)
+	//	Description:	RE and IM: replaces the value on top with its real
+	//						or imaginary part.  A real number is its own
+	//						real part, with an imaginary part of 0.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- CREAL or CIMAG
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			complexOperand(); stackTouched()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::complexPart(cmd thecmd)
+	{
+		double re, im;
+		if (m_stack.empty() || !complexOperand(m_stack.front(), re, im))
+		{
+			m_error = true;
+			return;
+		}
+		m_stack.pop_front();
+		stackTouched(m_stack.size());
+		m_stack.push_front((thecmd == CREAL) ? re : im);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			complexOperand(double value, double& re, double& im)
+	//	Description:	Reads a stack value as a complex number.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		double value -- the stack value
+	//					double& re, double& im -- receive its parts
+	//	Returns:		bool -- false for a matrix (or a stale handle)
+	//	Called by:		complexPart(); complexArith(); complexFunction()
+	//	Calls:			CComplexTable::get()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CRPNCalc::complexOperand(double value, double& re, double& im) const
+	{
+		if (!isBoxed(value))
+		{
+			re = value;
+			im = 0.0;
+			return true;
+		}
+		return m_complexes.get(value, re, im);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			complexArith(cmd thecmd)
+	//	Description:	+, -, *, / and ^ when either operand is complex.
+	//						In complex mode ^ also comes here for a negative
+	//						base and a fractional exponent, which has no
+	//						real result.  add(), subtract() and so on try
+	//						this first; it does nothing for two real
+	//						operands.  * and / go through the split-array
+	//						kernels.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- ADD, SUB, MULT, DIV or EXP
+	//	Returns:		bool -- true if the operation was done here (the
+	//						result, or the error flag, is then set)
+	//	Called by:		add(); subtract(); multiply(); divide(); exp()
+	//	Calls:			complexOperand(); complexMultiply();
+	//						complexDivide(); pushComplex()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CRPNCalc::complexArith(cmd thecmd)
+	{
+		double ar, ai, br, bi, cr, ci;
+
+		if (m_error || m_stack.size() < 2
+			|| !complexOperand(m_stack[0], br, bi)
+			|| !complexOperand(m_stack[1], ar, ai))
+			return false;
+		if (!isBoxed(m_stack[0]) && !isBoxed(m_stack[1])
+			&& !(m_complex && thecmd == EXP && ar < 0 && br != floor(br)))
+			return false;
+		switch (thecmd)
+		{
+		case ADD:
+			cr = ar + br;
+			ci = ai + bi;
+			break;
+		case SUB:
+			cr = ar - br;
+			ci = ai - bi;
+			break;
+		case MULT:
+			complexMultiply(&ar, &ai, &br, &bi, &cr, &ci, 1);
+			break;
+		case DIV:
+			if (br == 0 && bi == 0)
+			{
+				m_error = true;
+				return true;
+			}
+			complexDivide(&ar, &ai, &br, &bi, &cr, &ci, 1);
+			break;
+		default:
+		{
+			if (ar == 0 && ai == 0 && br == 0 && bi == 0)
+			{
+				m_error = true;
+				return true;
+			}
+			complex<double> c = pow(complex<double>(ar, ai),
+				complex<double>(br, bi));
+			cr = c.real();
+			ci = c.imag();
+			break;
+		}
+		}
+		m_stack.pop_front(2);
+		stackTouched(m_stack.size());
+		pushComplex(cr, ci);
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			complexFunction(cmd thecmd)
+	//	Description:	M, SQRT and the trig commands on a complex value.
+	//						In complex mode SQRT of a negative number and
+	//						ASIN or ACOS outside [-1, 1] come here too,
+	//						instead of giving NaN.  In degree mode the
+	//						argument of COS, SIN and TAN and the result of
+	//						the inverse functions are scaled as for reals.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- M, SQRT, COS, SIN, TAN, ACOS, ASIN
+	//						or ATAN
+	//	Returns:		bool -- true if the operation was done here
+	//	Called by:		neg(); _sqrt(); _cos(); _sin(); _tan(); _acos();
+	//						_asin(); _atan()
+	//	Calls:			complexOperand(); pushComplex()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CRPNCalc::complexFunction(cmd thecmd)
+	{
+		double re, im;
+		complex<double> z;
+		double toRadians = (m_trigmode == DEG) ? deg2rad(1.0) : 1.0;
+
+		if (m_stack.empty() || !complexOperand(m_stack.front(), re, im))
+			return false;
+		if (!isBoxed(m_stack.front()) && !(m_complex
+			&& ((thecmd == SQRT && re < 0)
+				|| ((thecmd == ASIN || thecmd == ACOS) && fabs(re) > 1))))
+			return false;
+		z = complex<double>(re, im);
+		switch (thecmd)
+		{
+		case M:
+			z = -z;
+			break;
+		case SQRT:
+			z = sqrt(z);
+			break;
+		case COS:
+			z = cos(z * toRadians);
+			break;
+		case SIN:
+			z = sin(z * toRadians);
+			break;
+		case TAN:
+			z = tan(z * toRadians);
+			break;
+		case ACOS:
+			z = acos(z) / toRadians;
+			break;
+		case ASIN:
+			z = asin(z) / toRadians;
+			break;
+		default:
+			z = atan(z) / toRadians;
+			break;
+		}
+		m_stack.pop_front();
+		stackTouched(m_stack.size());
+		pushComplex(z.real(), z.imag());
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			pushComplex(double re, double im)
+	//	Description:	Pushes re + im i; a value with no imaginary part is
+	//						pushed as a plain number.  Once the table holds
+	//						twice as many values as were alive after the
+	//						last collection, the unreachable ones are
+	//						collected first.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		double re, double im -- the parts
+	//	Returns:		None
+	//	Called by:		makeComplex(); complexArith(); complexFunction()
+	//	Calls:			collectValues(); CComplexTable::add()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::pushComplex(double re, double im)
+	{
+		if (im == 0.0)
+		{
+			m_stack.push_front(re);
+			return;
+		}
+		if (m_complexes.liveCount() >= m_complexLimit)
+		{
+			collectValues();
+			m_complexLimit = max<size_t>(COMPLEX_GC_MIN,
+				2 * m_complexes.liveCount());
+		}
+		m_stack.push_front(m_complexes.add(re, im));
+	}
+} // end namespace TPUS_CALC
@@ -1,15 +1,26 @@
 //----------------------------------------------------------------------------
 // CalcDriver.cpp
 //
-// functions:  main()
+// functions:  main(int argc, char* argv[])
+//					runBatchMode(int argc, char* argv[])
+//					runPackMode(int argc, char* argv[])
+//					runPipeMode(int argc, char* argv[])
+//					runRecordMode(int argc, char* argv[])
+//					runReplayMode(int argc, char* argv[])
 //					testOstream()
 //----------------------------------------------------------------------------
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 #include "RPNCalc.h"
 
 using namespace std;
 
+int runBatchMode(int argc, char* argv[]);
+int runPackMode(int argc, char* argv[]);
+int runPipeMode(int argc, char* argv[]);
+int runRecordMode(int argc, char* argv[]);
+int runReplayMode(int argc, char* argv[]);
 int testOstream();
 
 //----------------------------------------------------------------------------
@@ -32,19 +43,64 @@ int testOstream();
 //                  	Software:   MS Windows 7 for execution; 
 //                  	Compiles under Microsoft Visual C++.Net 2013
 // 
-//	Calls:		CRPNCalc constructor
+//				With -b the calculator instead runs in batch mode
+//				(see runBatchMode()); --pack builds a program library
+//				(see runPackMode()); -p chains programs into a
+//				pipeline (see runPipeMode()); -rec records a session and
+//				-replay plays one back (see runRecordMode() and
+//				runReplayMode()).  With -j name the session is
+//				journaled to name.wal and name.ckpt and recovered from
+//				them when the calculator starts.
+//
+//	Calls:		CRPNCalc constructor; runBatchMode(); runPackMode();
+//				runPipeMode(); runRecordMode(); runReplayMode();
+//				CRPNCalc::openJournal(); CRPNCalc::run()
 // 
 //	Returns:	EXIT_SUCCESS  = successful 
+//				EXIT_FAILURE  = a batch run or pipeline could not
+//								start, the library could not be built,
+//								the journal could not be opened or a
+//								trace could not be written or read
 //
 //	History Log:
 //			4/205/14  PB  completed version 1.0
 // Dev log:
 //			6/12/16 TG completed version 1.1
+//			10/19/26 DL added batch mode: rpncalc -b [file]
+//			10/19/26 DL moved batch mode to runBatchMode()
+//			10/19/26 DL added rpncalc --pack archive file.clc...
+//			10/19/26 DL added rpncalc -j name, a journaled session
+//			10/19/26 DL added rpncalc -p, a pipeline of programs
+//			10/19/26 DL added rpncalc -rec and -replay, session traces
 //----------------------------------------------------------------------------
-int main(void)
+int main(int argc, char* argv[])
 {
 	using TPUS_CALC::CRPNCalc;
 
+	if (argc > 1 && strcmp(argv[1], "-b") == 0)
+		return runBatchMode(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "--pack") == 0)
+		return runPackMode(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "-p") == 0)
+		return runPipeMode(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "-rec") == 0)
+		return runRecordMode(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "-replay") == 0)
+		return runReplayMode(argc, argv);
+	if (argc > 2 && strcmp(argv[1], "-j") == 0)
+	{
+		CRPNCalc journaledCalc(false);
+		if (!journaledCalc.openJournal(argv[2]))
+		{
+			cerr << "Cannot recover or journal " << argv[2]
+				<< " (" << argv[2] << ".ckpt will not load, or "
+				<< argv[2] << ".wal cannot be written)" << endl;
+			return EXIT_FAILURE;
+		}
+		journaledCalc.run();
+		return EXIT_SUCCESS;
+	}
+
 	CRPNCalc myCalc;
 
 	testOstream();
@@ -52,6 +108,256 @@ int main(void)
 	return EXIT_SUCCESS;
 }
 
+//------------------------------------------------------------------------
+//	Method:			runBatchMode(int argc, char* argv[])
+//	Description:	Runs a batch workload:
+//						rpncalc -b [file] [-o out] [-r 0,1,...] [-w]
+//							[-l library]
+//						The workload comes from file, or stdin if none is
+//						given.  Results go to stdout as text, or with -o
+//						to a columnar binary file holding the top of the
+//						stack, the registers listed with -r and the error
+//						flag of each line; -w writes that file on a
+//						separate thread.  -l opens a program library for
+//						L:name.
+//	Date:			10/19/2026
+//	Version:		1.0
+//	Programmer:		David Landry
+//	Parameters:		int argc, char* argv[] -- the command line
+//	Returns:		int - exit status
+//	Called by:		main()
+//	Calls:			CRPNCalc::runBatch(); CRPNCalc::openLibrary();
+//						CResultSink
+//	Input:			The workload.
+//	Output:			The results.
+//	Throws:			None
+//	Changelog:		10/19/2026	DL completed version 1.0
+//					10/19/2026	DL version 1.1, adding -l
+//------------------------------------------------------------------------
+int runBatchMode(int argc, char* argv[])
+{
+	using TPUS_CALC::CRPNCalc;
+	using TPUS_CALC::CBlockReader;
+	using TPUS_CALC::CResultSink;
+
+	const char* inName = 0;
+	const char* outName = 0;
+	const char* libraryName = 0;
+	vector<int> registers;
+	bool threaded = false;
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+			outName = argv[++i];
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+		{
+			for (const char* reg = argv[++i]; *reg; reg++)
+				if (*reg >= '0' && *reg <= '9')
+					registers.push_back(*reg - '0');
+		}
+		else if (strcmp(argv[i], "-w") == 0)
+			threaded = true;
+		else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+			libraryName = argv[++i];
+		else if (argv[i][0] != '-' && !inName)
+			inName = argv[i];
+		else
+		{
+			cerr << "Usage: rpncalc -b [file] [-o out] [-r 0,1,...] [-w]"
+				" [-l library]" << endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	CBlockReader reader = inName ? CBlockReader(inName) : CBlockReader(0);
+	if (!reader.isOpen())
+	{
+		cerr << "Cannot open " << inName << endl;
+		return EXIT_FAILURE;
+	}
+	CRPNCalc batchCalc(false);
+	if (libraryName && !batchCalc.openLibrary(libraryName))
+	{
+		cerr << "Cannot open library " << libraryName << endl;
+		return EXIT_FAILURE;
+	}
+	CResultSink sink;
+	if (outName && !sink.open(outName, registers, threaded))
+	{
+		cerr << "Cannot create " << outName << endl;
+		return EXIT_FAILURE;
+	}
+	batchCalc.runBatch(reader, cout, outName ? &sink : 0);
+	if (outName && !sink.close())
+	{
+		cerr << "Error writing " << outName << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+//------------------------------------------------------------------------
+//	Method:			runPackMode(int argc, char* argv[])
+//	Description:	Builds a program library:
+//						rpncalc --pack archive file.clc...
+//						Each program is loaded by its file name, so
+//						area.clc becomes L:AREA.
+//	Date:			10/19/2026
+//	Version:		1.0
+//	Programmer:		David Landry
+//	Parameters:		int argc, char* argv[] -- the command line
+//	Returns:		int - exit status
+//	Called by:		main()
+//	Calls:			CRPNCalc::packLibrary()
+//	Input:			The program files.
+//	Output:			The archive.
+//	Throws:			None
+//	Changelog:		10/19/2026	DL completed version 1.0
+//------------------------------------------------------------------------
+int runPackMode(int argc, char* argv[])
+{
+	using TPUS_CALC::CRPNCalc;
+
+	if (argc < 4)
+	{
+		cerr << "Usage: rpncalc --pack archive file.clc..." << endl;
+		return EXIT_FAILURE;
+	}
+	CRPNCalc packCalc(false);
+	return packCalc.packLibrary(argv[2], argc - 3, argv + 3, cerr)
+		? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+//------------------------------------------------------------------------
+//	Method:			runPipeMode(int argc, char* argv[])
+//	Description:	Runs each number in the input through a pipeline of
+//						programs, each stage on its own thread:
+//						rpncalc -p [-i file] a.clc b.clc...
+//						The numbers come from file, or stdin if none is
+//						given; the results go to stdout and the stage
+//						counters to stderr.
+//	Date:			10/19/2026
+//	Version:		1.0
+//	Programmer:		David Landry
+//	Parameters:		int argc, char* argv[] -- the command line
+//	Returns:		int - exit status
+//	Called by:		main()
+//	Calls:			CRPNCalc::runPipeline()
+//	Input:			The program files and the numbers.
+//	Output:			The results and the counters.
+//	Throws:			None
+//	Changelog:		10/19/2026	DL completed version 1.0
+//------------------------------------------------------------------------
+int runPipeMode(int argc, char* argv[])
+{
+	using TPUS_CALC::CRPNCalc;
+	using TPUS_CALC::CBlockReader;
+	const char* inName = 0;
+	int first = 2;
+	if (argc > 3 && strcmp(argv[2], "-i") == 0)
+	{
+		inName = argv[3];
+		first = 4;
+	}
+	if (first >= argc)
+	{
+		cerr << "Usage: rpncalc -p [-i file] a.clc b.clc..." << endl;
+		return EXIT_FAILURE;
+	}
+	CBlockReader reader = inName ? CBlockReader(inName) : CBlockReader(0);
+	if (!reader.isOpen())
+	{
+		cerr << "Cannot open " << inName << endl;
+		return EXIT_FAILURE;
+	}
+	return CRPNCalc::runPipeline(argc - first, argv + first, reader, cout,
+		cerr) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+//------------------------------------------------------------------------
+//	Method:			runRecordMode(int argc, char* argv[])
+//	Description:	Runs an ordinary session, recording every line typed
+//						(commands and answers to prompts alike) with
+//						the time it arrived:
+//						rpncalc -rec trace
+//	Date:			10/19/2026
+//	Version:		1.0
+//	Programmer:		David Landry
+//	Parameters:		int argc, char* argv[] -- the command line
+//	Returns:		int - exit status
+//	Called by:		main()
+//	Calls:			CRPNCalc::run()
+//	Input:			The session.
+//	Output:			The trace.
+//	Throws:			None
+//	Changelog:		10/19/2026	DL completed version 1.0
+//------------------------------------------------------------------------
+int runRecordMode(int argc, char* argv[])
+{
+	using TPUS_CALC::CRPNCalc;
+	using TPUS_CALC::CRecordBuf;
+
+	if (argc < 3)
+	{
+		cerr << "Usage: rpncalc -rec trace" << endl;
+		return EXIT_FAILURE;
+	}
+	CRecordBuf recorder(cin.rdbuf(), argv[2]);
+	if (!recorder.isOpen())
+	{
+		cerr << "Cannot write " << argv[2] << endl;
+		return EXIT_FAILURE;
+	}
+	streambuf* keyboard = cin.rdbuf(&recorder);
+	CRPNCalc recordedCalc(false);
+	recordedCalc.run();
+	cin.rdbuf(keyboard);
+	return EXIT_SUCCESS;
+}
+
+//------------------------------------------------------------------------
+//	Method:			runReplayMode(int argc, char* argv[])
+//	Description:	Plays a recorded session back with nothing on the
+//						screen and reports its throughput and per-command
+//						latencies:
+//						rpncalc -replay trace [-paced]
+//						The replay goes flat out unless -paced keeps it
+//						to the recorded times.
+//	Date:			10/19/2026
+//	Version:		1.0
+//	Programmer:		David Landry
+//	Parameters:		int argc, char* argv[] -- the command line
+//	Returns:		int - exit status
+//	Called by:		main()
+//	Calls:			CReplayBuf::read(); CRPNCalc::replaySession()
+//	Input:			The trace.
+//	Output:			The report.
+//	Throws:			None
+//	Changelog:		10/19/2026	DL completed version 1.0
+//------------------------------------------------------------------------
+int runReplayMode(int argc, char* argv[])
+{
+	using TPUS_CALC::CRPNCalc;
+	using TPUS_CALC::CReplayBuf;
+	using TPUS_CALC::TraceLine;
+
+	if (argc < 3)
+	{
+		cerr << "Usage: rpncalc -replay trace [-paced]" << endl;
+		return EXIT_FAILURE;
+	}
+	vector<TraceLine> lines;
+	if (!CReplayBuf::read(argv[2], lines))
+	{
+		cerr << "Cannot read a trace from " << argv[2] << endl;
+		return EXIT_FAILURE;
+	}
+	bool paced = argc > 3 && strcmp(argv[3], "-paced") == 0;
+	CRPNCalc replayCalc(false);
+	replayCalc.replaySession(lines, paced, cout);
+	return EXIT_SUCCESS;
+}
+
 //------------------------------------------------------------------------
 //	Method:			testOstream()
 //	Description:	tests << and >> operators
@@ -0,0 +1,69 @@
+//----------------------------------------------------------------------------
+//    Class:		CDualStack
+//
+//    File:       CalcDual.cpp
+//
+//    Description: This file contains the function definitions for
+//					CDualStack
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcDual.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CDualStack()
+	//	Description:	Creates an empty stack with one tangent lane.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CDualStack::CDualStack() : m_lanes(1)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			reset(size_t lanes)
+	//	Description:	Empties the stack and sets the number of tangents
+	//						each entry carries.
+	//	Programmers:	David Landry
+	//	Parameters:		size_t lanes -- seed directions (at least 1)
+	//	Called by:		CRPNCalc::differentiate()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CDualStack::reset(size_t lanes)
+	{
+		clear();
+		m_lanes = lanes;
+	}
+
+	//------------------------------------------------------------------------
+	//	Methods:		rotateDown(), rotateUp()
+	//	Description:	D and U: move the top entry to the bottom, or the
+	//						bottom entry to the top, with its tangents.
+	//	Programmers:	David Landry
+	//	Called by:		CRPNCalc::runDual()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CDualStack::rotateDown()
+	{
+		rotate(m_values.begin(), m_values.end() - 1, m_values.end());
+		rotate(m_tangents.begin(), m_tangents.end() - m_lanes,
+			m_tangents.end());
+	}
+
+	void CDualStack::rotateUp()
+	{
+		rotate(m_values.begin(), m_values.begin() + 1, m_values.end());
+		rotate(m_tangents.begin(), m_tangents.begin() + m_lanes,
+			m_tangents.end());
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------
+//    File:		CalcDual.h
+//
+//    Class:	CDualStack
+//----------------------------------------------------------------------------
+#ifndef CALCDUAL_H
+#define CALCDUAL_H
+
+#include <cstddef>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		CDualStack Class
+//
+//    Description:	The stack for forward-mode differentiation.  Each entry
+//						is a dual number: a value and lanes() tangents,
+//						one per seed direction, so a single pass through
+//						a program carries every derivative along with the
+//						value.  Values and tangents are kept in separate
+//						arrays, bottom entry first, each entry's tangents
+//						together; the chain rule for an operation is then
+//						the same short loop over the lanes of its
+//						operands, which the compiler vectorizes
+//						(dualCombine() and dualScale()).
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  class CDualStack:
+//
+//	  Properties:
+//		vector<double> m_values -- entry values, bottom first
+//		vector<double> m_tangents -- lanes tangents per entry, bottom first
+//		size_t m_lanes -- tangents per entry
+//
+//	  Methods:
+//
+//		inline:
+//			size_t lanes() const
+//			size_t size() const
+//			bool empty() const
+//			double& value(size_t i) -- i entries below the top
+//			double* tangent(size_t i) -- its tangents
+//			void push(double value) -- with zero tangents
+//			void push(double value, const double* tangent)
+//			void pop(size_t n)
+//			void clear()
+//
+//		non-inline:
+//			CDualStack();
+//			void reset(size_t lanes);
+//			void rotateDown();
+//			void rotateUp();
+//
+//	  Functions:
+//		void dualCombine(double* out, double ca, const double* ta, double cb,
+//			const double* tb, size_t n) -- out = ca * ta + cb * tb
+//		void dualScale(double* t, double k, size_t n) -- t *= k
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	inline void dualCombine(double* out, double ca, const double* ta,
+		double cb, const double* tb, size_t n)
+	{
+		for (size_t k = 0; k < n; k++)
+			out[k] = ca * ta[k] + cb * tb[k];
+	}
+
+	inline void dualScale(double* t, double k, size_t n)
+	{
+		for (size_t j = 0; j < n; j++)
+			t[j] *= k;
+	}
+
+	class CDualStack
+	{
+	public:
+		CDualStack();
+		void reset(size_t lanes);
+		size_t lanes() const { return m_lanes; }
+		size_t size() const { return m_values.size(); }
+		bool empty() const { return m_values.empty(); }
+		double& value(size_t i) { return m_values[m_values.size() - 1 - i]; }
+		double* tangent(size_t i)
+			{ return &m_tangents[(m_values.size() - 1 - i) * m_lanes]; }
+		void push(double value)
+		{
+			m_values.push_back(value);
+			m_tangents.resize(m_tangents.size() + m_lanes, 0.0);
+		}
+		void push(double value, const double* tangent)
+		{
+			m_values.push_back(value);
+			m_tangents.insert(m_tangents.end(), tangent, tangent + m_lanes);
+		}
+		void pop(size_t n = 1)
+		{
+			m_values.resize(m_values.size() - n);
+			m_tangents.resize(m_values.size() * m_lanes);
+		}
+		void clear() { m_values.clear(); m_tangents.clear(); }
+		void rotateDown();
+		void rotateUp();
+
+	private:
+		std::vector<double> m_values;
+		std::vector<double> m_tangents;
+		size_t m_lanes;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,269 @@
+#include "RPNCalc.h"
+#include "CalcDual.h"
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			differentiate(cmd thecmd)
+	//	Description:	DIFF and GRAD run the program once on dual numbers,
+	//						as a function of the registers on an empty
+	//						stack (as SOLVE does).  DIFF pushes f and then
+	//						df/dR0; "n GRAD" pops n and pushes f and then
+	//						df/dR0 ... df/dR(n-1), all n derivatives coming
+	//						from the same run.  The registers themselves are
+	//						left as they were.  The run is limited by
+	//						m_limits.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- DIFF or GRAD
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			compileProgram(); runDual(); CRunLimits::start();
+	//						CRunLimits::finish()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, enforcing
+	//									m_limits.
+	//------------------------------------------------------------------------
+	void CRPNCalc::differentiate(cmd thecmd)
+	{
+		double count = 1;
+		CDualStack stack;
+
+		if (thecmd == GRAD)
+		{
+			if (m_stack.empty() || isBoxed(m_stack.front()))
+			{
+				m_error = true;
+				return;
+			}
+			count = m_stack.front();
+		}
+		if (!(count >= 1 && count <= NUMREGS && count == floor(count)))
+		{
+			m_error = true;
+			return;
+		}
+		if (!m_program.compiled())
+			compileProgram();
+		stack.reset(static_cast<size_t>(count));
+		bool limited = m_limits.active() && !m_limits.running();
+		if (limited)
+			m_limits.start();
+		bool ran = runDual(stack);
+		// runDual() changes nothing outside stack, so a run stopped by a
+		//	limit has nothing to undo.
+		if (limited && m_limits.finish(stack.size()))
+			ran = false;
+		if (!ran || stack.empty() || isBoxed(stack.value(0)))
+		{
+			m_error = true;
+			return;
+		}
+		if (thecmd == GRAD)
+		{
+			m_stack.pop_front();
+			stackTouched(m_stack.size());
+		}
+		m_stack.push_front(stack.value(0));
+		for (size_t j = 0; j < stack.lanes(); j++)
+			m_stack.push_front(stack.tangent(0)[j]);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			runDual(CDualStack& stack)
+	//	Description:	Runs the compiled program on dual numbers, with
+	//						tangent lane j seeded as d/dRj.  Numbers, the
+	//						registers, named registers, arithmetic, ^, %,
+	//						M, SQRT, the trig commands, CE, C, D and U are
+	//						supported; any other command fails the run.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		CDualStack& stack -- empty, with one lane per
+	//						register to differentiate by; receives the
+	//						program's final stack
+	//	Returns:		bool -- false if a line failed or a limit stopped
+	//						the run
+	//	Called by:		differentiate()
+	//	Calls:			dualCombine(); dualScale(); CRunLimits::exceeded()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, checking
+	//									m_limits.
+	//------------------------------------------------------------------------
+	bool CRPNCalc::runDual(CDualStack& stack)
+	{
+		const vector<Instr>& code = m_program.code();
+		size_t lanes = stack.lanes();
+		double toRadians = (m_trigmode == DEG) ? deg2rad(1.0) : 1.0;
+		double registers[NUMREGS];
+		vector<double> regTangents(NUMREGS * lanes, 0.0);
+		vector<double> named(m_named);
+		vector<double> namedTangents(m_named.size() * lanes, 0.0);
+
+		registerValues(registers);
+		for (size_t j = 0; j < lanes; j++)
+			regTangents[j * lanes + j] = 1.0;
+		for (size_t i = 0; i < code.size() && code[i].op != STOP; i++)
+		{
+			if (m_limits.exceeded(stack.size()))
+				return false;
+			const Instr& instr = code[i];
+			cmd op = static_cast<cmd>(instr.op);
+			size_t operands = 0;
+			switch (op)
+			{
+			case ADD: case SUB: case MULT: case DIV: case EXP: case MOD:
+				operands = 2;
+				break;
+			case M: case SQRT: case SIN: case COS: case TAN:
+			case ASIN: case ACOS: case ATAN: case CLRE: case SETN:
+			case SR0: case SR1: case SR2: case SR3: case SR4:
+			case SR5: case SR6: case SR7: case SR8: case SR9:
+				operands = 1;
+				break;
+			default:
+				break;
+			}
+			if (stack.size() < operands)
+				return false;
+			for (size_t k = 0; k < operands; k++)
+				if (isBoxed(stack.value(k)))
+					return false;
+
+			double b = operands ? stack.value(0) : 0.0;	// top
+			double* tb = operands ? stack.tangent(0) : 0;
+			double a = (operands == 2) ? stack.value(1) : 0.0;
+			double* ta = (operands == 2) ? stack.tangent(1) : 0;
+			double v;
+			switch (op)
+			{
+			case NOP:
+				break;
+			case PUSH:
+				stack.push(instr.value);
+				break;
+			case GR0: case GR1: case GR2: case GR3: case GR4:
+			case GR5: case GR6: case GR7: case GR8: case GR9:
+				stack.push(registers[op - GR0],
+					&regTangents[(op - GR0) * lanes]);
+				break;
+			case SR0: case SR1: case SR2: case SR3: case SR4:
+			case SR5: case SR6: case SR7: case SR8: case SR9:
+				registers[op - SR0] = b;
+				copy(tb, tb + lanes, &regTangents[(op - SR0) * lanes]);
+				break;
+			case GETN:
+				stack.push(named[instr.slot],
+					&namedTangents[instr.slot * lanes]);
+				break;
+			case SETN:
+				named[instr.slot] = b;
+				copy(tb, tb + lanes, &namedTangents[instr.slot * lanes]);
+				break;
+			case CLRE:
+				stack.pop();
+				break;
+			case CLRA:
+				stack.clear();
+				break;
+			case DOWN: case UP:
+				if (stack.empty())
+					return false;
+				if (op == DOWN)
+					stack.rotateDown();
+				else
+					stack.rotateUp();
+				break;
+			case ADD:
+				dualCombine(ta, 1.0, ta, 1.0, tb, lanes);
+				stack.value(1) = a + b;
+				stack.pop();
+				break;
+			case SUB:
+				dualCombine(ta, 1.0, ta, -1.0, tb, lanes);
+				stack.value(1) = a - b;
+				stack.pop();
+				break;
+			case MULT:
+				dualCombine(ta, b, ta, a, tb, lanes);
+				stack.value(1) = a * b;
+				stack.pop();
+				break;
+			case DIV:
+				if (b == 0)
+					return false;
+				v = a / b;
+				dualCombine(ta, 1.0 / b, ta, -v / b, tb, lanes);
+				stack.value(1) = v;
+				stack.pop();
+				break;
+			case EXP:
+				if (a == 0 && b == 0)
+					return false;
+				// d(a^b) = b a^(b-1) da + a^b ln(a) db; the second term
+				//	only exists for a > 0, so lanes that move b are
+				//	undefined otherwise.
+				v = pow(a, b);
+				dualCombine(ta, b * pow(a, b - 1), ta,
+					(a > 0) ? v * log(a) : 0.0, tb, lanes);
+				if (a <= 0)
+					for (size_t j = 0; j < lanes; j++)
+						if (tb[j] != 0)
+							ta[j] = NAN;
+				stack.value(1) = v;
+				stack.pop();
+				break;
+			case MOD:
+				// fmod(a, b) = a - trunc(a / b) b, with the quotient
+				//	piecewise constant.
+				dualCombine(ta, 1.0, ta, -trunc(a / b), tb, lanes);
+				stack.value(1) = fmod(a, b);
+				stack.pop();
+				break;
+			case M:
+				dualScale(tb, -1.0, lanes);
+				stack.value(0) = -b;
+				break;
+			case SQRT:
+				v = sqrt(b);
+				dualScale(tb, 0.5 / v, lanes);
+				stack.value(0) = v;
+				break;
+			case SIN:
+				dualScale(tb, toRadians * cos(b * toRadians), lanes);
+				stack.value(0) = sin(b * toRadians);
+				break;
+			case COS:
+				dualScale(tb, -toRadians * sin(b * toRadians), lanes);
+				stack.value(0) = cos(b * toRadians);
+				break;
+			case TAN:
+				v = cos(b * toRadians);
+				dualScale(tb, toRadians / (v * v), lanes);
+				stack.value(0) = tan(b * toRadians);
+				break;
+			case ASIN:
+				dualScale(tb, 1.0 / (toRadians * sqrt(1 - b * b)), lanes);
+				stack.value(0) = asin(b) / toRadians;
+				break;
+			case ACOS:
+				dualScale(tb, -1.0 / (toRadians * sqrt(1 - b * b)), lanes);
+				stack.value(0) = acos(b) / toRadians;
+				break;
+			case ATAN:
+				dualScale(tb, 1.0 / (toRadians * (1 + b * b)), lanes);
+				stack.value(0) = atan(b) / toRadians;
+				break;
+			default:
+				return false;
+			}
+		}
+		return true;
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,169 @@
+//----------------------------------------------------------------------------
+//    Class:		CNumberFormat
+//
+//    File:       CalcFormat.cpp
+//
+//    Description: This file contains the function definitions for
+//					CNumberFormat
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+//						10/19/26 DL STD picks fixed or scientific by
+//							magnitude; NaN written explicitly
+// ---------------------------------------------------------------------------
+#include "CalcFormat.h"
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			set(FormatMode mode, int digits)
+	//	Description:	Selects the display mode.  digits is ignored for STD.
+	//	Programmers:	David Landry
+	//	Parameters:		FormatMode mode -- the mode
+	//					int digits -- places (0 - MAX_DIGITS)
+	//	Returns:		bool -- false (and no change) if digits is out of
+	//						range
+	//	Called by:		CRPNCalc::setFormat(); CRPNCalc::loadState()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CNumberFormat::set(FormatMode mode, int digits)
+	{
+		if (mode == FMT_STD)
+			digits = 0;
+		else if (digits < 0 || digits > MAX_DIGITS)
+			return false;
+		m_mode = mode;
+		m_digits = digits;
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			format(char* buffer, double value)
+	//	Description:	Writes value in the current mode.  The text is not
+	//						terminated.  STD asks to_chars for the shortest
+	//						fixed form between STD_FIXED_MIN and FIX_LIMIT
+	//						and the shortest scientific form outside it;
+	//						left to choose, to_chars writes 400000 as
+	//						4e+05.  NaN is written here because to_chars
+	//						writes -nan when the sign bit is set.
+	//	Programmers:	David Landry
+	//	Parameters:		char* buffer -- BUFFER_BYTES bytes
+	//					double value -- the number
+	//	Returns:		size_t -- the characters written
+	//	Called by:		write()
+	//	Calls:			to_chars(); engineering()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL fixed or scientific by magnitude in
+	//									STD; nan for every NaN
+	//------------------------------------------------------------------------
+	size_t CNumberFormat::format(char* buffer, double value) const
+	{
+		char* end = buffer + BUFFER_BYTES;
+		to_chars_result result;
+		double magnitude = fabs(value);
+		if (isnan(value))
+		{
+			memcpy(buffer, "nan", 3);
+			return 3;
+		}
+		else if (isinf(value))
+			result = to_chars(buffer, end, value);
+		else if (m_mode == FMT_STD)
+			result = to_chars(buffer, end, value, (magnitude == 0
+				|| (magnitude >= STD_FIXED_MIN && magnitude < FIX_LIMIT))
+				? chars_format::fixed : chars_format::scientific);
+		else if (m_mode == FMT_FIX && magnitude < FIX_LIMIT)
+			result = to_chars(buffer, end, value, chars_format::fixed,
+				m_digits);
+		else if (m_mode == FMT_ENG)
+			return engineering(buffer, value);
+		else
+			result = to_chars(buffer, end, value, chars_format::scientific,
+				m_digits);
+		return result.ptr - buffer;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			write(ostream& ostr, double value)
+	//	Description:	Formats value and writes the characters to ostr.
+	//	Programmers:	David Landry
+	//	Parameters:		ostream& ostr -- where to write
+	//					double value -- the number
+	//	Returns:		None
+	//	Called by:		CRPNCalc::printValue()
+	//	Calls:			format()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CNumberFormat::write(ostream& ostr, double value) const
+	{
+		char buffer[BUFFER_BYTES];
+		ostr.write(buffer, format(buffer, value));
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			engineering(char* buffer, double value)
+	//	Description:	ENG: rounds value to m_digits + 1 significant digits
+	//						through to_chars' scientific form, then moves
+	//						the point right until the exponent is a
+	//						multiple of 3.  Rounding first means 999.96 in
+	//						ENG 3 becomes 1.000e+03, not 1000.e+00.
+	//	Programmers:	David Landry
+	//	Parameters:		char* buffer -- BUFFER_BYTES bytes
+	//					double value -- a finite number
+	//	Returns:		size_t -- the characters written
+	//	Called by:		format()
+	//	Calls:			to_chars()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	size_t CNumberFormat::engineering(char* buffer, double value) const
+	{
+		char scientific[BUFFER_BYTES];
+		to_chars_result result = to_chars(scientific,
+			scientific + sizeof(scientific), value, chars_format::scientific,
+			m_digits);
+		const char* e = static_cast<const char*>(
+			memchr(scientific, 'e', result.ptr - scientific));
+		int exponent = atoi(e + 1);
+		int shift = (exponent % 3 + 3) % 3;
+		exponent -= shift;
+
+		// The mantissa's digits, without the sign or the point.
+		const char* scan = scientific;
+		char* out = buffer;
+		char digits[BUFFER_BYTES];
+		size_t count = 0;
+		if (*scan == '-')
+			*out++ = *scan++;
+		for (; scan < e; scan++)
+			if (*scan != '.')
+				digits[count++] = *scan;
+		while (count < static_cast<size_t>(shift) + 1)
+			digits[count++] = '0';
+
+		memcpy(out, digits, shift + 1);
+		out += shift + 1;
+		if (count > static_cast<size_t>(shift) + 1)
+		{
+			*out++ = '.';
+			memcpy(out, digits + shift + 1, count - shift - 1);
+			out += count - shift - 1;
+		}
+		*out++ = 'e';
+		*out++ = (exponent < 0) ? '-' : '+';
+		exponent = abs(exponent);
+		if (exponent < 10)
+			*out++ = '0';
+		out = to_chars(out, buffer + BUFFER_BYTES, exponent).ptr;
+		return out - buffer;
+	}
+} // end namespace TPUS_CALC
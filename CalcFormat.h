@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------
+//    File:		CalcFormat.h
+//
+//    Class:	CNumberFormat
+//----------------------------------------------------------------------------
+#ifndef CALCFORMAT_H
+#define CALCFORMAT_H
+
+#include <cstddef>
+#include <ostream>
+//----------------------------------------------------------------------------
+//
+//    Title:		CNumberFormat Class
+//
+//    Description:	Formats the numbers the calculator shows, with
+//						std::to_chars straight into a buffer on the stack
+//						(no locale, no stream state, no allocation).
+//						The display modes are:
+//							STD -- the shortest text that reads back as
+//								exactly the same double, so #p shows
+//								3.141592653589793; plain digits from
+//								STD_FIXED_MIN up to FIX_LIMIT (and 0),
+//								an exponent outside that range
+//							FIX n -- n places after the point; values of
+//								FIX_LIMIT or more show as SCI n
+//							SCI n -- one digit, n places and an exponent
+//							ENG n -- n + 1 significant digits and an
+//								exponent that is a multiple of 3
+//						Infinities and NaN show as inf, -inf and nan in
+//						every mode; a NaN's sign is not shown.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  enum FormatMode -- the display modes
+//
+//	  class CNumberFormat:
+//
+//	  Properties:
+//		FormatMode m_mode -- the display mode
+//		int m_digits -- places for FIX, SCI and ENG (0 - MAX_DIGITS)
+//
+//	  Methods:
+//
+//		inline:
+//			CNumberFormat() -- STD
+//			FormatMode mode() const
+//			int digits() const
+//
+//		non-inline:
+//			bool set(FormatMode mode, int digits);
+//			size_t format(char* buffer, double value) const;
+//			void write(std::ostream& ostr, double value) const;
+//		private:
+//			size_t engineering(char* buffer, double value) const;
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+//			10/19/26 DL STD keeps large and tiny values in exponent form
+//				(STD_FIXED_MIN); every NaN shows as nan
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	enum FormatMode { FMT_STD, FMT_FIX, FMT_SCI, FMT_ENG };
+
+	class CNumberFormat
+	{
+	public:
+		static const int MAX_DIGITS = 17;			// enough for any double
+		static const size_t BUFFER_BYTES = 64;		// format()'s buffer
+		static constexpr double FIX_LIMIT = 1e15;
+		static constexpr double STD_FIXED_MIN = 1e-5;
+
+		CNumberFormat() : m_mode(FMT_STD), m_digits(0) {}
+		bool set(FormatMode mode, int digits);
+		size_t format(char* buffer, double value) const;
+		void write(std::ostream& ostr, double value) const;
+		FormatMode mode() const { return m_mode; }
+		int digits() const { return m_digits; }
+
+	private:
+		size_t engineering(char* buffer, double value) const;
+
+		FormatMode m_mode;
+		int m_digits;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,43 @@
+#include "RPNCalc.h"
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			setFormat(cmd thecmd)
+	//	Description:	STD shows every number in the shortest form that
+	//						reads back exactly.  "n FIX", "n SCI" and
+	//						"n ENG" show n places in fixed, scientific or
+	//						engineering notation.  Only the display
+	//						changes; the numbers keep their full precision.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- STD, FIX, SCI or ENG
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			CNumberFormat::set(); stackTouched()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::setFormat(cmd thecmd)
+	{
+		if (thecmd == STD)
+		{
+			m_format.set(FMT_STD, 0);
+			return;
+		}
+		FormatMode mode = (thecmd == FIX) ? FMT_FIX
+			: (thecmd == SCI) ? FMT_SCI : FMT_ENG;
+		double places = m_stack.empty() ? NAN : m_stack.front();
+		if (!(places >= 0 && places <= CNumberFormat::MAX_DIGITS)
+			|| places != floor(places))
+		{
+			m_error = true;
+			return;
+		}
+		m_format.set(mode, static_cast<int>(places));
+		m_stack.pop_front();
+		stackTouched(m_stack.size());
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,147 @@
+#include "RPNCalc.h"
+#include <charconv>
+#include <cstdint>
+#include "CalcMappedFile.h"
+namespace TPUS_CALC
+{
+	static bool bigEndianHost()
+	{
+		const uint16_t one = 1;
+		return *reinterpret_cast<const unsigned char*>(&one) == 0;
+	}
+
+	static bool separator(char c)
+	{
+		return c == ',' || isspace(static_cast<unsigned char>(c));
+	}
+
+	// Counts the runs of text between separators: every number in the
+	//	file, plus anything that is not one (which fails the import).
+	static size_t countTokens(const char* scan, const char* end)
+	{
+		size_t found = 0;
+		bool inToken = false;
+		for (; scan < end; scan++)
+		{
+			bool between = separator(*scan);
+			if (!between && !inToken)
+				found++;
+			inToken = !between;
+		}
+		return found;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			importFile(const char* fileName, bool binary)
+	//	Description:	Pushes every number in a file onto the stack, in
+	//						file order, so the last one ends up on top.  A
+	//						text file holds numbers separated by newlines,
+	//						commas or blanks; it is scanned once to count
+	//						them, the stack is grown once, and then each is
+	//						parsed with from_chars straight out of the
+	//						mapped file.  A binary file is raw little-endian
+	//						doubles.  If anything in the file is not a
+	//						number the stack is left as it was.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		const char* fileName -- the file
+	//					bool binary -- raw doubles instead of text
+	//	Returns:		bool -- true if the file was imported
+	//	Called by:		importData(); a host process loading a dataset
+	//	Calls:			CMappedFile; CCalcStack::reserve(); from_chars()
+	//	Input:			The file.
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL counting the numbers, not the lines
+	//									and commas, so blank-separated
+	//									files are also grown once
+	//------------------------------------------------------------------------
+	bool CRPNCalc::importFile(const char* fileName, bool binary)
+	{
+		CMappedFile file(fileName);
+		const char* scan = file.data();
+		const char* end = scan + file.size();
+		size_t pushed = 0;
+
+		if (!file.isOpen())
+			return false;
+		if (binary)
+		{
+			if (file.size() % sizeof(double) != 0)
+				return false;
+			bool swap = bigEndianHost();
+			m_stack.reserve(file.size() / sizeof(double));
+			for (; scan < end; scan += sizeof(double))
+			{
+				char bytes[sizeof(double)];
+				double value;
+				memcpy(bytes, scan, sizeof(double));
+				if (swap)
+					reverse(bytes, bytes + sizeof(double));
+				memcpy(&value, bytes, sizeof(double));
+				m_stack.push_front(isBoxed(value) ? NAN : value);
+			}
+			return true;
+		}
+
+		m_stack.reserve(countTokens(scan, end));
+		for (;;)
+		{
+			while (scan < end && separator(*scan))
+				scan++;
+			if (scan == end)
+				return true;
+			if (*scan == '+')
+				scan++;
+			double value;
+			from_chars_result result = from_chars(scan, end, value);
+			if (result.ec != errc()
+				|| (result.ptr < end && !separator(*result.ptr)))
+			{
+				m_stack.pop_front(pushed);
+				return false;
+			}
+			m_stack.push_front(value);
+			pushed++;
+			scan = result.ptr;
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			importData()
+	//	Description:	Asks the user for a file name and imports the
+	//						numbers in it onto the stack
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			importFile()
+	//	Input:			The file name.
+	//	Output:			Prompts for the file name and error messages, if
+	//						applicable.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::importData()
+	{
+		char fileName[BUFFER_SIZE];
+		size_t length;
+		size_t before = m_stack.size();
+		cout << "Please enter the name of a file of numbers to import."
+			<< endl;
+		cout << "(Text, or raw doubles if the name ends in .bin)  ";
+		(cin >> fileName).get();
+		length = strlen(fileName);
+		if (importFile(fileName, length > 4
+			&& strcmp(fileName + length - 4, ".bin") == 0))
+			cout << "Imported " << m_stack.size() - before
+				<< " numbers.  Press \"Enter\" to continue.";
+		else
+			cout << "Could not import the file.  Press \"Enter\" to continue.";
+		cin.get();
+	}
+} // end namespace TPUS_CALC
@@ -1,4 +1,5 @@
 #include "RPNCalc.h"
+#include <charconv>
 #include <iterator>
 namespace TPUS_CALC
 {
@@ -11,7 +12,7 @@ namespace TPUS_CALC
 	//	Parameters:		istream &instr, a reference to an input stream.
 	//	Returns:		None
 	//	Called by:		run()
-	//	Calls:			parse()
+	//	Calls:			reloadIfChanged(); parse(); journalLine()
 	//	Input:			A number, constant escape sequence, or command.
 	//	Output:			None
 	//	Throws:			None
@@ -24,26 +25,46 @@ namespace TPUS_CALC
 	//									sure the string stream is pure and
 	//									ready for action.
 	//					6/12/2016	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, dropping the
+	//									copy into m_instrStream; parse()
+	//									reads m_buffer directly.
+	//					10/19/2026	DL completed version 1.2, keeping an
+	//									undo point for each line that changes
+	//									the stack or registers.
+	//					10/19/2026	DL completed version 1.3, remembering
+	//									the line's command in m_lineCmd.
+	//					10/19/2026	DL completed version 1.4, reloading a
+	//									watched program before the line runs.
+	//					10/19/2026	DL completed version 1.5, journaling the
+	//									line.
 	//------------------------------------------------------------------------
 	void CRPNCalc::input(istream &instr)
 	{
-		m_instrStream.clear();
 		getline(instr, m_buffer);
 		m_buffer += '\n';
-		m_instrStream.str(m_buffer);
-		parse();
+		reloadIfChanged();
+		CSnapshot before = snapshot();
+		m_lineCmd = parse();
+		if (m_lineCmd != UNDO && m_lineCmd != REDO && stateChanged(before))
+		{
+			m_undo.push_back(before);
+			if (m_undo.size() > MAXUNDO)
+				m_undo.pop_front();
+			m_redo.clear();
+		}
+		journalLine();
 	}
 
 	//------------------------------------------------------------------------
 	//	Method:			parse()
-	//	Description:	Parses the next command from m_instrStream
-	//	Date:			6/12/2016
-	//	Version:		1.0.1
+	//	Description:	Parses and executes the line in m_buffer
+	//	Date:			10/19/2026
+	//	Version:		1.2
 	//	Programmers:	Thurman Gillespy and David Landry
 	//	Parameters:		None
-	//	Returns:		None
+	//	Returns:		cmd -- the command the line compiled to
 	//	Called by:		input()
-	//	Calls:			cmd_parse()
+	//	Calls:			compileLine(); execute()
 	//	Input:			None
 	//	Output:			None
 	//	Throws:			None
@@ -59,117 +80,210 @@ namespace TPUS_CALC
 	//									bug where entering a decimal without
 	//									a leading 0 would have caused an error
 	//									(e.g., .5 instead of 0.5).
+	//					10/19/2026	DL	completed version 1.0.2, recording the
+	//									executed command in m_lastCmd.
+	//					10/19/2026	DL	completed version 1.1, moving the
+	//									parsing into compileLine() so program
+	//									lines can be compiled once.
+	//					10/19/2026	DL	completed version 1.2, returning the
+	//									line's command; m_lastCmd ends up
+	//									holding the last command a program
+	//									ran.
 	//------------------------------------------------------------------------
-	void CRPNCalc::parse()
+	cmd CRPNCalc::parse()
 	{
-		string	icommand;
-		double	afloat;
-		ostringstream oss;
-		char	c = '\0';
+		Instr instr = compileLine(m_buffer.c_str(), m_buffer.size(), -1);
+		execute(instr);
+		return static_cast<cmd>(instr.op);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			compileLine(const char* text, size_t len, int line)
+	//	Description:	Turns one line of input into an instruction.  The
+	//						input is either a number, a constant, a
+	//						named register access or a command; anything
+	//						else compiles to NOVAL, which sets the error
+	//						flag when executed.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		const char* text -- the line, '\n' optional
+	//					size_t len -- length of the line
+	//					int line -- program line index (-1 for typed input)
+	//	Returns:		Instr -- the compiled line
+	//	Called by:		parse(); compileProgram()
+	//	Calls:			from_chars()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0, taking over the
+	//									number and constant handling from
+	//									parse() and the command lookup from
+	//									cmd_parse().
+	//					10/19/2026	DL named registers (G:name, S:name)
+	//					10/19/2026	DL library programs (L:name)
+	//------------------------------------------------------------------------
+	Instr CRPNCalc::compileLine(const char* text, size_t len, int line)
+	{
+		Instr instr;
+		const char* end = text + len;
+		const char* scan = text;
 		bool isNegative = false;
 		bool isDecimal = false;
 
-		// input is either a number, a constant or a command
-		// check for a number
-		if (m_buffer == "\n")
-			;
-		else
+		instr.op = NOVAL;
+		instr.line = line;
+		instr.value = 0.0;
+		if (scan < end && end[-1] == '\n')
+			end--;
+		if (scan == end)
 		{
-			if (m_instrStream.peek() == '-')
-			{
-				m_instrStream.get();
-				if (isdigit(m_instrStream.peek()) || m_instrStream.peek() == '.')
-					isNegative = true;
-				else
-					m_instrStream.putback('-');
-			}
-			if (m_instrStream.peek() == '+')
+			instr.op = NOP;
+			return instr;
+		}
+		// G:name and S:name are resolved to a named register slot here, so
+		//	running them is a plain indexed load or store; L:name is
+		//	resolved to a program name slot the same way.
+		if (end - scan > 2 && scan[1] == ':' && (toupper(scan[0]) == 'G'
+			|| toupper(scan[0]) == 'S' || toupper(scan[0]) == 'L'))
+		{
+			string name(scan + 2, end);
+			for (size_t i = 0; i < name.size(); i++)
 			{
-				m_instrStream.get();
-				if (isdigit(m_instrStream.peek()) || m_instrStream.peek() == '.')
-					isNegative = false;
-				else
-					m_instrStream.putback('+');
+				if (!isalnum(static_cast<unsigned char>(name[i]))
+					&& name[i] != '_')
+					return instr;
+				name[i] = toupper(name[i]);
 			}
-			if (m_instrStream.peek() == '.')
+			if (toupper(scan[0]) == 'L')
 			{
-				m_instrStream.get();
-				isDecimal = true;
+				instr.op = LOADN;
+				instr.slot = m_programNames.intern(name.data(), name.size());
+				return instr;
 			}
-			if (isdigit(m_instrStream.peek()))
+			instr.op = (toupper(scan[0]) == 'G') ? GETN : SETN;
+			instr.slot = m_names.intern(name.data(), name.size());
+			if (m_named.size() < m_names.size())
+				m_named.resize(m_names.size(), 0.0);
+			return instr;
+		}
+		// A sign only belongs to the number if a digit or . follows it.
+		if ((*scan == '-' || *scan == '+') && scan + 1 < end
+			&& (isdigit(scan[1]) || scan[1] == '.'))
+		{
+			isNegative = (*scan == '-');
+			scan++;
+		}
+		if (scan < end && *scan == '.')
+		{
+			scan++;
+			isDecimal = true;
+		}
+		// check for a number
+		if (scan < end && isdigit(*scan))
+		{
+			double afloat = 0.0;
+			from_chars_result result = from_chars(scan, end, afloat);
+			// Error if anything else is on the line.
+			if (result.ec == errc() && result.ptr == end)
 			{
-				if (m_instrStream >> afloat)
-				{
-					// Error if anything else in the stream.
-					if (m_instrStream.peek() != '\n')
-						m_error = true;
-					else
-					{
-						afloat = isNegative ? -afloat : afloat;
-						if (isDecimal)
-							while (fabs(afloat) >= 1)
-								afloat /= 10;
-						m_stack.push_front(afloat);
-					}
-				}
-				else
-				{
-					m_error = true;
-				}
+				afloat = isNegative ? -afloat : afloat;
+				if (isDecimal)
+					while (fabs(afloat) >= 1)
+						afloat /= 10;
+				instr.op = PUSH;
+				instr.value = afloat;
 			}
-			// check for constants
-			else if (m_instrStream.peek() == '#')
+		}
+		// check for constants
+		else if (scan < end && *scan == '#')
+		{
+			char c = (scan + 1 < end) ? tolower(scan[1]) : '\0';
+			instr.op = PUSH;
+			switch (c)
 			{
-				// remove *
-				m_instrStream.get();
-				c = m_instrStream.get();
-				c = tolower(c);
-				switch (c)
-				{
-				case 'e':
-					if (!m_programRunning)
-						m_stack.push_front(CONST_E);
-					else
-						m_program.push_back("#e");
-					break;
-				case 'p':
-					if (!m_programRunning)
-						m_stack.push_front(CONST_PI);
-					else
-						m_program.push_back("#p");
-					break;
-				case 'c': // speed of light
-					if (!m_programRunning)
-						m_stack.push_front(CONST_C);
-					else
-						m_program.push_back("#c");
-					break;
-				default:
-					m_error = true;
-					break;
-				}
+			case 'e':
+				instr.value = CONST_E;
+				break;
+			case 'p':
+				instr.value = CONST_PI;
+				break;
+			case 'c': // speed of light
+				instr.value = CONST_C;
+				break;
+			default:
+				instr.op = NOVAL;
+				break;
 			}
+		}
+		else
+		{
+			// Put together the command (1 cmd/line) and look it up.
+			string command(text, end);
+			for (size_t i = 0; i < command.size(); i++)
+				if (isalpha(command[i]))
+					command[i] = toupper(command[i]);
+			RPNmap::iterator it = m_map.find(command);
+			if (it != m_map.end())
+				instr.op = it->second;
+		}
+		return instr;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			execute(const Instr& instr)
+	//	Description:	Runs one compiled instruction.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		const Instr& instr -- the instruction
+	//	Returns:		None
+	//	Called by:		parse(); runProgram(); runInstrumented()
+	//	Calls:			cmd_parse(); loadFromLibrary()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL LOADN (L:name)
+	//------------------------------------------------------------------------
+	void CRPNCalc::execute(const Instr& instr)
+	{
+		m_lastCmd = static_cast<cmd>(instr.op);
+		switch (instr.op)
+		{
+		case PUSH:
+			m_stack.push_front(instr.value);
+			break;
+		case NOP:
+			break;
+		case GETN:
+			m_stack.push_front(m_named[instr.slot]);
+			break;
+		case SETN:
+			if (m_stack.empty())
+				m_error = true;
 			else
-			{
-				// Call the method to handle commands
-				m_buffer = m_instrStream.str();
-				cmd_parse();
-			}
+				m_named[instr.slot] = m_stack.front();
+			break;
+		case LOADN:
+			loadFromLibrary(instr.slot);
+			break;
+		default:
+			cmd_parse(m_lastCmd);
+			break;
 		}
-		m_instrStream.clear();
-		m_instrStream.ignore(BUFFER_SIZE, '\n');
 	}
 
 	//------------------------------------------------------------------------
-	//	Method:			cmd_parse()
+	//	Method:			cmd_parse(cmd thecmd)
 	//	Description:	Handles commands and operators, directing traffic to
 	//						the appropriate methods.
 	//	Date:			6/12/2016
 	//	Version:		1.0
 	//	Programmers:	Thurman Gillespy and David Landry
-	//	Parameters:		None
+	//	Parameters:		cmd thecmd -- the command to run
 	//	Returns:		None
-	//	Called by:		parse()
+	//	Called by:		execute()
 	//	Calls:			add(); subtract(); multiply(); divide(); mod(); exp();
 	//					clearEntry(); clearAll();
 	//					rotateDown(); rotateUp();
@@ -186,29 +300,45 @@ namespace TPUS_CALC
 	//					6/11/2016	DL completed version 0.9, adding this
 	//									method header.
 	//					6/12/2016	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, adding TRACE and
+	//									TX and recording m_lastCmd for the
+	//									tracer.
+	//					10/19/2026	DL completed version 1.2, adding PROF
+	//									and PL.
+	//					10/19/2026	DL completed version 1.3, taking the
+	//									command as a parameter; the lookup
+	//									moved to compileLine().
+	//					10/19/2026	DL completed version 1.4, adding UNDO,
+	//									REDO, SNAP and RECALL.
+	//					10/19/2026	DL completed version 1.5, adding CKPT
+	//									and RESUME.
+	//					10/19/2026	DL completed version 1.6, adding the
+	//									stack reductions.
+	//					10/19/2026	DL completed version 1.7, adding IMP.
+	//					10/19/2026	DL completed version 1.8, adding the
+	//									matrix commands.
+	//					10/19/2026	DL completed version 1.9, adding the
+	//									complex commands; H steps through
+	//									the help pages.
+	//					10/19/2026	DL completed version 1.10, adding SOLVE
+	//									and INTEG.
+	//					10/19/2026	DL completed version 1.11, adding DIFF
+	//									and GRAD.
+	//					10/19/2026	DL completed version 1.12, adding W.
+	//					10/19/2026	DL completed version 1.13, adding LIB.
+	//					10/19/2026	DL completed version 1.14, adding MAP,
+	//									UNMAP, CAS and FADD.
+	//					10/19/2026	DL completed version 1.15, adding SIG.
+	//					10/19/2026	DL completed version 1.16, adding STD,
+	//									FIX, SCI and ENG.
+	//					10/19/2026	DL completed version 1.17, adding WIN,
+	//									WPUSH, WAVG, WMIN, WMAX and WSTD.
+	//					10/19/2026	DL completed version 1.18, adding LIMI,
+	//									LIMS and LIMT.
 	//------------------------------------------------------------------------
-	void CRPNCalc::cmd_parse()
+	void CRPNCalc::cmd_parse(cmd thecmd)
 	{
-		string command;
-		char c = ' ';
-		int counter = -1;
-		// Put together the command.
-		while (m_buffer[++counter] != '\n')	// This works for 1 cmd/line
-		{
-			if (isalpha(m_buffer[counter]))
-				command += toupper(m_buffer[counter]);
-			else
-				command += m_buffer[counter];
-		}
-
-		// Find the matching mapped command or write the command to a program
-		//	node.
-		cmd	thecmd = NOVAL;
 		int regVal = -1;
-		map<string, cmd>::iterator it;
-		it = m_map.find(command);
-		if (it != m_map.end())
-			thecmd = it->second;
 		// ADD, SUB, MULT, DIV, EXP, MOD, CLR, CLRE, DOWN, UP, FILE, GREG0,
 		// GREG1, GREG2, GREG3, GREG4, GREG5, GREG6, GREG7, GREG8, GREG9,
 		// SREG0, SREG1, SREG2, SREG3, SREG4, SREG5, SREG6, SREG7, SREG8, 
@@ -246,7 +376,17 @@ namespace TPUS_CALC
 			rotateUp();
 			break;
 		case HELP:
-			m_helpOn = (m_helpOn == true) ? false : true; //toggle help on/off
+			// next help page; off after the last, back to the first
+			if (!m_helpOn)
+			{
+				m_helpOn = true;
+				m_helpPage = 0;
+			}
+			else if (++m_helpPage == HELP_PAGES)
+			{
+				m_helpOn = false;
+				m_helpPage = 0;
+			}
 			break;
 		case FILE:
 			saveToFile();
@@ -297,6 +437,102 @@ namespace TPUS_CALC
 		case RUN:
 			runProgram();
 			break;
+		case TRACE:
+			m_trace.enable(!m_trace.enabled());	// toggle tracing on/off
+			break;
+		case TRACEX:
+			exportTrace();
+			break;
+		case PROF:
+			m_profileOn = !m_profileOn;	// toggle profiling; restart counts
+			if (m_profileOn)
+				m_profile.clear();
+			break;
+		case PROFL:
+			printProfile();
+			break;
+		case UNDO:
+			undo();
+			break;
+		case REDO:
+			redo();
+			break;
+		case SNAP:
+			saveSnapshot();
+			break;
+		case RECALL:
+			recallSnapshot();
+			break;
+		case CKPT:
+			checkpoint();
+			break;
+		case RESUME:
+			resume();
+			break;
+		case RSUM: case RMEAN: case RVAR: case RMIN: case RMAX:
+		case NSUM: case NMEAN: case NVAR: case NMIN: case NMAX: case DOT:
+			reduce(thecmd);
+			break;
+		case IMP:
+			importData();
+			break;
+		case MAT:
+			makeMatrix();
+			break;
+		case MUNPK:
+			unpackMatrix();
+			break;
+		case CPLX:
+			m_complex = !m_complex;
+			break;
+		case CJOIN:
+			makeComplex();
+			break;
+		case CREAL: case CIMAG:
+			complexPart(thecmd);
+			break;
+		case SOLVE: case INTEG:
+			solve(thecmd);
+			break;
+		case DIFF: case GRAD:
+			differentiate(thecmd);
+			break;
+		case WATCH:
+			watchProgram();
+			break;
+		case LIB:
+			loadLibrary();
+			break;
+		case MAP:
+			mapRegister();
+			break;
+		case UNMAP:
+			unmapRegister();
+			break;
+		case CAS: case FADD:
+			sharedOp(thecmd);
+			break;
+		case SIG:
+			stackSignature();
+			break;
+		case STD: case FIX: case SCI: case ENG:
+			setFormat(thecmd);
+			break;
+		case WIN:
+			setWindow();
+			break;
+		case WPUSH:
+			windowPush();
+			break;
+		case WAVG: case WMIN: case WMAX: case WSTD:
+			windowAggregate(thecmd);
+			break;
+		case LIMI: case LIMS: case LIMT:
+			setLimit(thecmd);
+			break;
+		case MTRANS: case MDET: case MSOLVE:
+			matrixOp(thecmd);
+			break;
 		case EXIT:
 			m_on = OFF;
 			cout << "Press \"Enter\" to exit the calculator.";
@@ -306,4 +542,4 @@ namespace TPUS_CALC
 			break;
 		}
 	}
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,442 @@
+//----------------------------------------------------------------------------
+//    Class:		CJournal
+//
+//    File:       CalcJournal.cpp
+//
+//    Description: This file contains the function definitions for
+//					CJournal
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.1
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+//						10/19/26 DL completed version 1.1, one committer
+//							for every journal; syncDirectory()
+//						10/19/26 DL close() waits out a round that still
+//							holds the journal's records
+// ---------------------------------------------------------------------------
+#include "CalcJournal.h"
+#include "CalcMappedFile.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#include <sys/stat.h>
+#define SYS_WRITE ::_write
+#define SYS_CLOSE ::_close
+#define SYS_SYNC ::_commit
+#define SYS_TRUNCATE(fd) ::_chsize_s(fd, 0)
+#else
+#include <unistd.h>
+#define SYS_WRITE ::write
+#define SYS_CLOSE ::close
+#if defined(__linux__)
+#define SYS_SYNC ::fdatasync
+#else
+#define SYS_SYNC ::fsync
+#endif
+#define SYS_TRUNCATE(fd) ::ftruncate(fd, 0)
+#endif
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	constexpr chrono::milliseconds CJournal::GROUP_WINDOW;
+
+	static uint32_t check(const char* data, size_t len)
+	{
+		uint32_t hash = 2166136261u;
+		for (size_t i = 0; i < len; i++)
+		{
+			hash ^= static_cast<unsigned char>(data[i]);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	// write(2) until everything is out or it fails.
+	static bool writeAll(int fd, const char* data, size_t size)
+	{
+		while (size > 0)
+		{
+			long done = static_cast<long>(SYS_WRITE(fd, data,
+				static_cast<unsigned>(size)));
+			if (done < 0 && errno == EINTR)
+				continue;
+			if (done <= 0)
+				return false;
+			data += done;
+			size -= done;
+		}
+		return true;
+	}
+
+	mutex CJournal::s_openClose;
+	mutex CJournal::s_lock;
+	condition_variable CJournal::s_changed;
+	vector<CJournal*> CJournal::s_open;
+	thread CJournal::s_committer;
+	size_t CJournal::s_waiters = 0;
+	bool CJournal::s_stopping = false;
+
+	//------------------------------------------------------------------------
+	//	Method:			CJournal()
+	//	Description:	Creates a closed journal.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CJournal::CJournal() : m_fd(-1), m_appended(0), m_durable(0),
+		m_failed(false), m_inRound(false)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			~CJournal()
+	//	Description:	Commits what is left and closes the journal.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CJournal::~CJournal()
+	{
+		close();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			open(const char* fileName)
+	//	Description:	Opens (or creates) the journal for appending and
+	//						hands it to the committer, starting the
+	//						committer if this is the only open journal.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* fileName -- the journal file
+	//	Returns:		bool -- false if the file cannot be opened
+	//	Called by:		CRPNCalc::openJournal()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL joining the shared committer
+	//------------------------------------------------------------------------
+	bool CJournal::open(const char* fileName)
+	{
+		close();
+		lock_guard<mutex> openClose(s_openClose);
+#ifdef _WIN32
+		m_fd = _open(fileName, _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY,
+			_S_IREAD | _S_IWRITE);
+#else
+		m_fd = ::open(fileName, O_WRONLY | O_CREAT | O_APPEND, 0644);
+#endif
+		if (m_fd < 0)
+			return false;
+		{
+			lock_guard<mutex> guard(s_lock);
+			m_pending.clear();
+			m_appended = 0;
+			m_durable = 0;
+			m_failed = false;
+			s_open.push_back(this);
+		}
+		if (!s_committer.joinable())
+			s_committer = thread(&CJournal::commitLoop);
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			append(const char* data, size_t len)
+	//	Description:	Adds a record.  It goes out with the committer's
+	//						next round, within about GROUP_WINDOW; it is
+	//						only durable once sync() returns.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* data, size_t len -- the payload
+	//	Called by:		reset(); CRPNCalc::journalLine()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CJournal::append(const char* data, size_t len)
+	{
+		uint32_t frame[2] = { static_cast<uint32_t>(len), check(data, len) };
+		if (m_fd < 0)
+			return;
+		{
+			lock_guard<mutex> guard(s_lock);
+			const char* head = reinterpret_cast<const char*>(frame);
+			m_pending.insert(m_pending.end(), head, head + sizeof(frame));
+			m_pending.insert(m_pending.end(), data, data + len);
+			m_appended++;
+		}
+		s_changed.notify_all();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			sync()
+	//	Description:	Waits until every record appended so far is durable.
+	//						The committer stops waiting for company as soon
+	//						as anyone is blocked here; records other
+	//						journals appended by then share the round.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- false if a write or sync has failed
+	//	Called by:		reset(); close(); CRPNCalc::journalLine();
+	//						CRPNCalc::compactJournal()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CJournal::sync()
+	{
+		if (m_fd < 0)
+			return false;
+		unique_lock<mutex> lock(s_lock);
+		uint64_t target = m_appended;
+		s_waiters++;
+		s_changed.notify_all();
+		s_changed.wait(lock,
+			[this, target]() { return m_durable >= target || m_failed; });
+		s_waiters--;
+		return !m_failed;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			reset(const char* data, size_t len)
+	//	Description:	Empties the journal and starts it again with one
+	//						record, durably.  Used once the journal's
+	//						contents are safe in a snapshot.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* data, size_t len -- the first record
+	//	Returns:		bool -- false if the journal could not be reset
+	//	Called by:		CRPNCalc::compactJournal()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CJournal::reset(const char* data, size_t len)
+	{
+		if (!sync())
+			return false;
+		// The committer is done with this journal: nothing is pending and
+		//	only this thread appends.
+		if (SYS_TRUNCATE(m_fd) != 0)
+			return false;
+		append(data, len);
+		return sync();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			close()
+	//	Description:	Commits what is left, takes the journal from the
+	//						committer (stopping it if no journal is left)
+	//						and closes the file.  sync() returns at once
+	//						on a failed journal, so this also waits for
+	//						any round still writing the journal's records
+	//						before the descriptor goes away.
+	//	Programmers:	David Landry
+	//	Called by:		open(); ~CJournal(); CRPNCalc::journalLine()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL leaving the shared committer
+	//					10/19/2026	DL waiting out the committer's round
+	//------------------------------------------------------------------------
+	void CJournal::close()
+	{
+		if (m_fd < 0)
+			return;
+		lock_guard<mutex> openClose(s_openClose);
+		sync();
+		bool last;
+		{
+			unique_lock<mutex> lock(s_lock);
+			s_changed.wait(lock, [this]() { return !m_inRound; });
+			// Out of s_open under the same lock, so no later round can
+			//	take a share; records a failed journal never wrote are
+			//	dropped.
+			m_pending.clear();
+			s_open.erase(find(s_open.begin(), s_open.end(), this));
+			last = s_open.empty();
+			s_stopping = last;
+		}
+		if (last)
+		{
+			s_changed.notify_all();
+			s_committer.join();
+			s_stopping = false;
+		}
+		SYS_CLOSE(m_fd);
+		m_fd = -1;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			commitLoop()
+	//	Description:	The committer thread: gathers the pending records of
+	//						every open journal into one round, writes and
+	//						syncs each journal's share, and wakes anyone in
+	//						sync().  It ends when the last journal closes.
+	//	Programmers:	David Landry
+	//	Called by:		open() (as a thread)
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL serving every open journal
+	//------------------------------------------------------------------------
+	void CJournal::commitLoop()
+	{
+		// One journal's share of a round.
+		struct Share
+		{
+			CJournal* journal;
+			vector<char> records;
+			uint64_t upto;
+			bool written;
+		};
+		vector<Share> round;
+		auto pendingBytes = []()
+		{
+			size_t bytes = 0;
+			for (size_t i = 0; i < s_open.size(); i++)
+				bytes += s_open[i]->m_pending.size();
+			return bytes;
+		};
+		unique_lock<mutex> lock(s_lock);
+		for (;;)
+		{
+			s_changed.wait(lock,
+				[&]() { return pendingBytes() > 0 || s_stopping; });
+			if (s_stopping)
+				return;
+			s_changed.wait_for(lock, GROUP_WINDOW, [&]()
+			{
+				return s_stopping || s_waiters > 0
+					|| pendingBytes() >= GROUP_BYTES;
+			});
+			// A journal with a share in this round is marked m_inRound;
+			//	close() waits for the mark to clear before closing m_fd.
+			round.clear();
+			for (size_t i = 0; i < s_open.size(); i++)
+			{
+				CJournal* journal = s_open[i];
+				if (journal->m_pending.empty())
+					continue;
+				Share share = { journal, vector<char>(), journal->m_appended,
+					false };
+				share.records.swap(journal->m_pending);
+				journal->m_inRound = true;
+				round.push_back(std::move(share));
+			}
+			lock.unlock();
+			for (size_t i = 0; i < round.size(); i++)
+			{
+				int fd = round[i].journal->m_fd;
+				round[i].written = writeAll(fd, &round[i].records[0],
+					round[i].records.size()) && SYS_SYNC(fd) == 0;
+			}
+			lock.lock();
+			for (size_t i = 0; i < round.size(); i++)
+			{
+				if (round[i].written)
+					round[i].journal->m_durable = round[i].upto;
+				else
+					round[i].journal->m_failed = true;
+				round[i].journal->m_inRound = false;
+			}
+			s_changed.notify_all();
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			read(const char* fileName, vector<string>& records)
+	//	Description:	Reads a journal's records, up to the first torn or
+	//						damaged one.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* fileName -- the journal file
+	//					vector<string>& records -- receives the payloads
+	//	Returns:		bool -- false if the file cannot be read
+	//	Called by:		CRPNCalc::openJournal()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CJournal::read(const char* fileName, vector<string>& records)
+	{
+		CMappedFile file(fileName);
+		records.clear();
+		if (!file.isOpen())
+			return false;
+		const char* scan = file.data();
+		const char* end = scan + file.size();
+		uint32_t frame[2];
+		while (static_cast<size_t>(end - scan) >= sizeof(frame))
+		{
+			memcpy(frame, scan, sizeof(frame));
+			scan += sizeof(frame);
+			if (frame[0] > static_cast<size_t>(end - scan)
+				|| check(scan, frame[0]) != frame[1])
+				break;
+			records.push_back(string(scan, frame[0]));
+			scan += frame[0];
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			fingerprint(const char* fileName)
+	//	Description:	64-bit FNV-1a of a file's contents; a missing file
+	//						hashes like an empty one.
+	//	Programmers:	David Landry
+	//	Returns:		uint64_t -- the hash
+	//	Called by:		CRPNCalc::openJournal(); CRPNCalc::compactJournal()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	uint64_t CJournal::fingerprint(const char* fileName)
+	{
+		CMappedFile file(fileName);
+		uint64_t hash = 14695981039346656037ULL;
+		const unsigned char* data
+			= reinterpret_cast<const unsigned char*>(file.data());
+		for (size_t i = 0; file.isOpen() && i < file.size(); i++)
+		{
+			hash ^= data[i];
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			syncFile(const char* fileName)
+	//	Description:	Makes a file just written through a stream durable.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- false if it could not be synced
+	//	Called by:		CRPNCalc::compactJournal()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CJournal::syncFile(const char* fileName)
+	{
+#ifdef _WIN32
+		int fd = _open(fileName, _O_RDWR | _O_BINARY);
+#else
+		int fd = ::open(fileName, O_RDONLY);
+#endif
+		if (fd < 0)
+			return false;
+		bool synced = SYS_SYNC(fd) == 0;
+		SYS_CLOSE(fd);
+		return synced;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			syncDirectory(const char* fileName)
+	//	Description:	Makes a rename into the directory holding fileName
+	//						durable.  Windows has no directory handles to
+	//						sync; its renames go through the file system's
+	//						own log.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- false if the directory could not be synced
+	//	Called by:		CRPNCalc::compactJournal()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CJournal::syncDirectory(const char* fileName)
+	{
+#ifdef _WIN32
+		(void)fileName;
+		return true;
+#else
+		const char* slash = strrchr(fileName, '/');
+		string directory = slash ? string(fileName, slash - fileName + 1) : ".";
+		int fd = ::open(directory.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+		bool synced = ::fsync(fd) == 0;
+		SYS_CLOSE(fd);
+		return synced;
+#endif
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------
+//    File:		CalcJournal.h
+//
+//    Class:	CJournal
+//----------------------------------------------------------------------------
+#ifndef CALCJOURNAL_H
+#define CALCJOURNAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		CJournal Class
+//
+//    Description:	An append-only journal file with group commit.
+//						append() only frames a record into memory and
+//						returns.  One committer thread serves every
+//						journal open in the process: each round it takes
+//						whatever has piled up in all of them, writes each
+//						journal's share with one write(2) and syncs each
+//						with one fdatasync.  After waking for a record it
+//						waits up to GROUP_WINDOW for more to join the
+//						round, unless someone is blocked in sync() or
+//						GROUP_BYTES are already waiting, so a burst of
+//						input, or several sessions typing at once, costs
+//						one round, not one per line.  A record is only
+//						durable once sync() has returned.
+//
+//						Record: uint32 length, uint32 FNV-1a check of the
+//						payload, payload.  A crash can leave a torn record
+//						at the end; read() stops at the first record that
+//						is short or fails its check.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.1
+//
+//	  Properties:
+//		int m_fd -- the journal file (-1 if closed)
+//		vector<char> m_pending -- records not yet handed to the committer
+//		uint64_t m_appended -- records appended since open()
+//		uint64_t m_durable -- records written and synced
+//		bool m_failed -- a write or sync failed
+//		bool m_inRound -- the committer holds a share of this journal
+//			that it has not finished writing
+//
+//	  Shared by all journals:
+//		mutex s_openClose -- serializes open() and close()
+//		mutex s_lock -- guards everything below and the properties
+//			above except m_fd
+//		condition_variable s_changed -- signals any change
+//		vector<CJournal*> s_open -- the open journals
+//		thread s_committer -- the committer thread
+//		size_t s_waiters -- threads blocked in sync()
+//		bool s_stopping -- the committer should finish up
+//
+//	  Methods:
+//
+//		inline:
+//			bool isOpen() const
+//
+//		non-inline:
+//			CJournal();
+//			~CJournal();
+//			bool open(const char* fileName);
+//			void append(const char* data, size_t len);
+//			bool sync();
+//			bool reset(const char* data, size_t len);
+//			void close();
+//			static bool read(const char* fileName,
+//				vector<string>& records);
+//			static uint64_t fingerprint(const char* fileName);
+//			static bool syncFile(const char* fileName);
+//			static bool syncDirectory(const char* fileName);
+//		private:
+//			static void commitLoop();
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+//			10/19/26 DL one committer thread shared by all journals;
+//				added syncDirectory()
+//			10/19/26 DL close() waits out the committer's round (m_inRound)
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	class CJournal
+	{
+	public:
+		static constexpr std::chrono::milliseconds GROUP_WINDOW{ 10 };
+		static const size_t GROUP_BYTES = 64 * 1024;
+
+		CJournal();
+		~CJournal();
+		bool open(const char* fileName);
+		void append(const char* data, size_t len);
+		bool sync();
+		bool reset(const char* data, size_t len);
+		void close();
+		bool isOpen() const { return m_fd >= 0; }
+		static bool read(const char* fileName,
+			std::vector<std::string>& records);
+		static uint64_t fingerprint(const char* fileName);
+		static bool syncFile(const char* fileName);
+		static bool syncDirectory(const char* fileName);
+
+	private:
+		CJournal(const CJournal&);					// not copyable
+		CJournal& operator=(const CJournal&);
+		static void commitLoop();
+
+		int m_fd;
+		std::vector<char> m_pending;
+		uint64_t m_appended;
+		uint64_t m_durable;
+		bool m_failed;
+		bool m_inRound;
+
+		static std::mutex s_openClose;
+		static std::mutex s_lock;
+		static std::condition_variable s_changed;
+		static std::vector<CJournal*> s_open;
+		static std::thread s_committer;
+		static size_t s_waiters;
+		static bool s_stopping;
+	};
+} // end namespace TPUS_CALC
+
+#endif
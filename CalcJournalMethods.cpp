@@ -0,0 +1,229 @@
+#include "RPNCalc.h"
+#include <cstdint>
+#include <cstdio>
+namespace TPUS_CALC
+{
+	// The journal's first record names the snapshot it continues from.
+	const char JOURNAL_MAGIC[8] = { 'R', 'P', 'N', 'W', 'A', 'L', '1', '\0' };
+
+	static string journalHeader(uint64_t snapshotHash)
+	{
+		string header(JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+		header.append(reinterpret_cast<const char*>(&snapshotHash),
+			sizeof(snapshotHash));
+		return header;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			openJournal(const char* baseName)
+	//	Description:	Recovers the session kept under baseName and keeps
+	//						journaling it.  The state is baseName.ckpt, a
+	//						saveState() image, plus every line journaled
+	//						in baseName.wal since that image was taken;
+	//						the lines are replayed through parse() as if
+	//						they were typed again.  The journal's first
+	//						record holds the fingerprint of the image it
+	//						follows, so a journal left over from before the
+	//						last compaction (a crash between the two
+	//						steps) is recognized and not replayed twice.
+	//						The recovered state is then compacted at once.
+	//						If the image exists but cannot be loaded
+	//						(damaged, or from a newer version), nothing is
+	//						replayed or written and both files are left as
+	//						they are.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		const char* baseName -- the session's files, without
+	//						the extension
+	//	Returns:		bool -- false if the snapshot cannot be loaded or
+	//						the journal cannot be written
+	//	Called by:		main()
+	//	Calls:			loadState(); CJournal::read(); parse();
+	//						CJournal::open(); compactJournal()
+	//	Input:			The snapshot and the journal.
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, failing without
+	//									touching the files when the snapshot
+	//									will not load.
+	//------------------------------------------------------------------------
+	bool CRPNCalc::openJournal(const char* baseName)
+	{
+		string snapshotName = string(baseName) + ".ckpt";
+		string journalName = string(baseName) + ".wal";
+		vector<string> records;
+
+		m_journal.close();
+		m_journalBase = baseName;
+		// A snapshot that is there but will not load must not be replaced
+		//	by whatever the journal rebuilds on an empty calculator.
+		if (ifstream(snapshotName.c_str()) && !loadState(snapshotName.c_str()))
+			return false;
+		if (CJournal::read(journalName.c_str(), records) && !records.empty()
+			&& records[0] == journalHeader(
+				CJournal::fingerprint(snapshotName.c_str())))
+		{
+			for (size_t i = 1; i < records.size(); i++)
+			{
+				m_buffer = records[i];
+				parse();
+			}
+			m_error = false;
+		}
+		if (!m_journal.open(journalName.c_str()))
+			return false;
+		if (!compactJournal())
+		{
+			m_journal.close();
+			return false;
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			journalLine()
+	//	Description:	Journals the line input() just ran.  A line that
+	//						replays the same way is appended, and input()
+	//						does not return until the committer has made
+	//						it durable (sessions typing at once share the
+	//						sync); any other
+	//						line that may have changed the state -- one
+	//						that prompted, undid, or loaded from the
+	//						library -- is captured by compacting instead.
+	//						Every JOURNAL_COMPACT_LINES lines the journal
+	//						is compacted anyway, and on X the session is
+	//						compacted and closed.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		input()
+	//	Calls:			replayable(); CJournal::append(); CJournal::sync();
+	//						compactJournal()
+	//	Input:			None
+	//	Output:			The journal.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, waiting for the
+	//									line to be durable.
+	//------------------------------------------------------------------------
+	void CRPNCalc::journalLine()
+	{
+		if (!m_journal.isOpen() || m_lineCmd == NOVAL || m_lineCmd == NOP)
+			return;
+		if (m_lineCmd == EXIT)
+		{
+			compactJournal();
+			m_journal.close();
+		}
+		else if (!replayable(m_lineCmd))
+			compactJournal();
+		else
+		{
+			m_journal.append(m_buffer.data(), m_buffer.size());
+			m_journal.sync();
+			if (++m_journalLines >= JOURNAL_COMPACT_LINES)
+				compactJournal();
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			replayable(cmd thecmd)
+	//	Description:	Tells whether running a line again from the same
+	//						state gives the same state: it must not read
+	//						more input, depend on the undo history, the
+	//						library or the clock, or run a program that
+	//						does.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- the line's command
+	//	Returns:		bool -- true if the line can go in the journal
+	//	Called by:		journalLine()
+	//	Calls:			promptsUser(); canEvaluate()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, a run under a
+	//									time limit is not replayable.
+	//------------------------------------------------------------------------
+	bool CRPNCalc::replayable(cmd thecmd) const
+	{
+		bool shared = false;
+		for (int i = 0; i < NUMREGS; i++)
+			shared = shared || m_shared[i] >= 0;
+		if (promptsUser(thecmd) || thecmd == UNDO || thecmd == REDO
+			|| thecmd == LOADN || thecmd == MAP || thecmd == UNMAP
+			|| thecmd == CAS || thecmd == FADD)
+			return false;
+		// Other sessions can change a shared register at any time.
+		if (shared && (thecmd == RUN || thecmd == SOLVE || thecmd == INTEG
+			|| thecmd == DIFF || thecmd == GRAD
+			|| (thecmd >= GR0 && thecmd <= GR9 && m_shared[thecmd - GR0] >= 0)
+			|| (thecmd >= SR0 && thecmd <= SR9 && m_shared[thecmd - SR0] >= 0)))
+			return false;
+		// Whether a time limit stops a run depends on the machine.
+		if (m_limits.millis() && (thecmd == RUN || thecmd == SOLVE
+			|| thecmd == INTEG || thecmd == DIFF || thecmd == GRAD))
+			return false;
+		return thecmd != RUN || canEvaluate();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			compactJournal()
+	//	Description:	Replaces the journal with a fresh snapshot of the
+	//						whole state.  The image is written beside the
+	//						old one, synced and renamed over it, and the
+	//						rename synced into the directory; only then
+	//						is the journal emptied and restarted with the
+	//						new image's fingerprint.  A crash at any point
+	//						leaves an image and journal that recover the
+	//						same state.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		bool -- false if the snapshot or the journal could
+	//						not be written (the old ones stay in use)
+	//	Called by:		openJournal(); journalLine(); reloadIfChanged()
+	//	Calls:			CJournal::sync(); saveState(); CJournal::syncFile();
+	//						CJournal::syncDirectory();
+	//						CJournal::fingerprint(); CJournal::reset()
+	//	Input:			None
+	//	Output:			The snapshot and the journal.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, syncing the
+	//									directory after the rename.
+	//------------------------------------------------------------------------
+	bool CRPNCalc::compactJournal()
+	{
+		string snapshotName = m_journalBase + ".ckpt";
+		string tempName = snapshotName + ".tmp";
+
+		if (!m_journal.sync() || !saveState(tempName.c_str())
+			|| !CJournal::syncFile(tempName.c_str()))
+			return false;
+		if (std::rename(tempName.c_str(), snapshotName.c_str()) != 0)
+		{
+			// rename() will not replace a file on every platform.
+			std::remove(snapshotName.c_str());
+			if (std::rename(tempName.c_str(), snapshotName.c_str()) != 0)
+				return false;
+		}
+		// Until the directory is synced a crash can bring back the old
+		//	image, which the emptied journal would no longer match.
+		if (!CJournal::syncDirectory(snapshotName.c_str()))
+			return false;
+		string header = journalHeader(
+			CJournal::fingerprint(snapshotName.c_str()));
+		if (!m_journal.reset(header.data(), header.size()))
+			return false;
+		m_journalLines = 0;
+		return true;
+	}
+} // end namespace TPUS_CALC
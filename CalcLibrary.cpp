@@ -0,0 +1,163 @@
+//----------------------------------------------------------------------------
+//    Class:		CLibrary
+//
+//    File:       CalcLibrary.cpp
+//
+//    Description: This file contains the function definitions for
+//					CLibrary
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcLibrary.h"
+#include <cstring>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	// Tells whether [offset, offset + bytes) lies within size bytes.
+	static bool inside(uint64_t offset, uint64_t bytes, uint64_t size)
+	{
+		return offset <= size && bytes <= size - offset;
+	}
+
+	//------------------------------------------------------------------------
+	//	Function:		libraryHash(const char* name, size_t len)
+	//	Description:	32-bit FNV-1a of a program name.  It is part of the
+	//						file format, so it must never change.
+	//	Programmers:	David Landry
+	//	Returns:		uint32_t -- the hash
+	//	Called by:		CLibrary::find(); CRPNCalc::packLibrary()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	uint32_t libraryHash(const char* name, size_t len)
+	{
+		uint32_t hash = 2166136261u;
+		for (size_t i = 0; i < len; i++)
+		{
+			hash ^= static_cast<unsigned char>(name[i]);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			CLibrary()
+	//	Description:	Creates a library with no archive open.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CLibrary::CLibrary() : m_header(0), m_buckets(0), m_entries(0)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			open(const char* fileName)
+	//	Description:	Maps an archive and checks that its header, index
+	//						and every entry's parts lie within the file, so
+	//						find() and the loader can trust them.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* fileName -- the archive
+	//	Returns:		bool -- false if it cannot be read or is not a
+	//						valid archive (any archive open before stays
+	//						closed)
+	//	Called by:		CRPNCalc::openLibrary()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CLibrary::open(const char* fileName)
+	{
+		close();
+		unique_ptr<CMappedFile> file(new CMappedFile(fileName));
+		if (!file->isOpen() || file->size() < sizeof(LibraryHeader))
+			return false;
+
+		const char* base = file->data();
+		uint64_t size = file->size();
+		const LibraryHeader* header
+			= reinterpret_cast<const LibraryHeader*>(base);
+		if (memcmp(header->magic, "RPNLIB\0\0", 8) != 0
+			|| header->version != LIBRARY_VERSION
+			|| header->totalSize > size
+			|| header->buckets == 0
+			|| (header->buckets & (header->buckets - 1)) != 0
+			|| header->buckets < header->programs
+			|| header->bucketOffset % 8 != 0 || header->entryOffset % 8 != 0
+			|| !inside(header->bucketOffset,
+				header->buckets * sizeof(uint32_t), size)
+			|| !inside(header->entryOffset,
+				header->programs * sizeof(LibraryEntry), size))
+			return false;
+		const uint32_t* buckets
+			= reinterpret_cast<const uint32_t*>(base + header->bucketOffset);
+		const LibraryEntry* entries
+			= reinterpret_cast<const LibraryEntry*>(base + header->entryOffset);
+		for (uint32_t b = 0; b < header->buckets; b++)
+			if (buckets[b] > header->programs)
+				return false;
+		for (uint32_t e = 0; e < header->programs; e++)
+		{
+			const LibraryEntry& entry = entries[e];
+			if (!inside(entry.nameOffset, entry.nameBytes, size)
+				|| !inside(entry.textOffset, entry.textBytes, size)
+				|| entry.codeOffset % 8 != 0
+				|| entry.codeCount > size / sizeof(LibraryInstr)
+				|| !inside(entry.codeOffset,
+					entry.codeCount * sizeof(LibraryInstr), size)
+				|| !inside(entry.namesOffset, entry.namesBytes, size))
+				return false;
+		}
+		m_file.swap(file);
+		m_header = header;
+		m_buckets = buckets;
+		m_entries = entries;
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			close()
+	//	Description:	Unmaps the archive.
+	//	Programmers:	David Landry
+	//	Called by:		open()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CLibrary::close()
+	{
+		m_file.reset();
+		m_header = 0;
+		m_buckets = 0;
+		m_entries = 0;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			find(const char* name, size_t len)
+	//	Description:	Looks a program up by name.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* name, size_t len -- the name
+	//	Returns:		const LibraryEntry* -- null if it is not there
+	//	Called by:		CRPNCalc::loadFromLibrary()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	const LibraryEntry* CLibrary::find(const char* name, size_t len) const
+	{
+		if (!m_header)
+			return 0;
+		uint32_t hash = libraryHash(name, len);
+		uint32_t mask = m_header->buckets - 1;
+		for (uint32_t probe = 0; probe <= mask; probe++)
+		{
+			uint32_t index = m_buckets[(hash + probe) & mask];
+			if (index == 0)
+				return 0;
+			const LibraryEntry* entry = &m_entries[index - 1];
+			if (entry->hash == hash && entry->nameBytes == len
+				&& memcmp(data() + entry->nameOffset, name, len) == 0)
+				return entry;
+		}
+		return 0;
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------
+//    File:		CalcLibrary.h
+//
+//    Class:	CLibrary
+//----------------------------------------------------------------------------
+#ifndef CALCLIBRARY_H
+#define CALCLIBRARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "CalcMappedFile.h"
+//----------------------------------------------------------------------------
+//
+//    Title:		CLibrary Class
+//
+//    Description:	A read-only program library: one archive file holding
+//						many programs, each with its source text and its
+//						compiled code, found by name through a hash table
+//						at the front of the file.  The archive is mapped
+//						once and checked when it is opened; after that a
+//						lookup is a hash, a probe or two and a name
+//						compare, with no file access at all.
+//
+//						Layout (native byte order, 8-byte aligned parts):
+//							LibraryHeader
+//							buckets: uint32 per bucket, entry index + 1
+//								(0 = empty), linear probing
+//							LibraryEntry x programs
+//							names, source text, code and register names
+//						An entry's code is LibraryInstr records.  The
+//						named registers (G:, S:) and programs (L:) the
+//						code uses are numbered per program and listed in
+//						that order, one per line, each with a G or L in
+//						front, so the loader can map them to its own
+//						slots.  The code is only valid for the command
+//						set it was compiled with: opTable is a hash of
+//						the packing calculator's keyword to opcode
+//						table, and when the loading calculator's
+//						differs (a command added, removed or
+//						renumbered) the loader compiles the source.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.1
+//
+//	  struct LibraryHeader, LibraryEntry, LibraryInstr -- the file format
+//
+//	  class CLibrary:
+//
+//	  Properties:
+//		unique_ptr<CMappedFile> m_file -- the mapped archive
+//		const LibraryHeader* m_header -- its header
+//		const uint32_t* m_buckets -- the name index
+//		const LibraryEntry* m_entries -- the programs
+//
+//	  Methods:
+//
+//		inline:
+//			bool isOpen() const
+//			const char* data() const -- base of every offset
+//			uint32_t opCount() const
+//			uint32_t opTable() const
+//			uint32_t programs() const
+//
+//		non-inline:
+//			CLibrary();
+//			bool open(const char* fileName);
+//			void close();
+//			const LibraryEntry* find(const char* name, size_t len) const;
+//
+//	  Functions:
+//		uint32_t libraryHash(const char* name, size_t len) -- FNV-1a
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+//			10/19/26 DL completed version 1.1, format 2: the header
+//				holds a hash of the opcode table (opTable)
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	const uint32_t LIBRARY_VERSION = 2;
+
+	struct LibraryHeader
+	{
+		char magic[8];				// "RPNLIB\0\0"
+		uint32_t version;
+		uint32_t opCount;			// NUMCMDS of the packing calculator
+		uint32_t opTable;			// its commandTableHash()
+		uint32_t programs;
+		uint32_t buckets;			// a power of two
+		uint32_t unused;			// keeps the offsets 8-byte aligned
+		uint64_t bucketOffset;
+		uint64_t entryOffset;
+		uint64_t totalSize;
+	};
+
+	struct LibraryEntry
+	{
+		uint64_t nameOffset;
+		uint32_t nameBytes;
+		uint32_t hash;
+		uint64_t textOffset;
+		uint64_t textBytes;
+		uint64_t codeOffset;
+		uint64_t codeCount;
+		uint64_t namesOffset;
+		uint64_t namesBytes;
+	};
+
+	struct LibraryInstr
+	{
+		int32_t op;
+		int32_t line;
+		union
+		{
+			double value;
+			int64_t slot;			// GETN, SETN, LOADN: index in the names
+		};
+	};
+
+	uint32_t libraryHash(const char* name, size_t len);
+
+	class CLibrary
+	{
+	public:
+		CLibrary();
+		bool open(const char* fileName);
+		void close();
+		const LibraryEntry* find(const char* name, size_t len) const;
+		bool isOpen() const { return m_header != 0; }
+		const char* data() const
+			{ return reinterpret_cast<const char*>(m_header); }
+		uint32_t opCount() const { return m_header->opCount; }
+		uint32_t opTable() const { return m_header->opTable; }
+		uint32_t programs() const { return m_header->programs; }
+
+	private:
+		std::unique_ptr<CMappedFile> m_file;
+		const LibraryHeader* m_header;
+		const uint32_t* m_buckets;
+		const LibraryEntry* m_entries;
+	};
+} // end namespace TPUS_CALC
+
+#endif
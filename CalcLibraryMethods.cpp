@@ -0,0 +1,381 @@
+#include "RPNCalc.h"
+#include <cstdint>
+namespace TPUS_CALC
+{
+	static uint64_t align8(uint64_t n)
+	{
+		return (n + 7) & ~static_cast<uint64_t>(7);
+	}
+
+	// Tells whether an instruction's slot is a name (register or program).
+	static bool usesName(int op)
+	{
+		return op == GETN || op == SETN || op == LOADN;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			packLibrary(const char* archive, int count,
+	//						char* files[], ostream& log)
+	//	Description:	Packs .clc program files into one library archive
+	//						(see CLibrary for the layout).  A program is
+	//						named after its file, without the directory
+	//						or the .clc, in upper case: lib/area.clc is
+	//						AREA, loaded with L:AREA.  Each program is
+	//						compiled here, so loading it needs no compile.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		const char* archive -- the archive to write
+	//					int count, char* files[] -- the program files
+	//					ostream& log -- progress and error messages
+	//	Returns:		bool -- true if the archive was written
+	//	Called by:		runPackMode()
+	//	Calls:			CProgram::read(); compileLine(); libraryHash();
+	//						commandTableHash()
+	//	Input:			The program files.
+	//	Output:			The archive.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, recording the
+	//									opcode table's hash.
+	//------------------------------------------------------------------------
+	bool CRPNCalc::packLibrary(const char* archive, int count, char* files[],
+		ostream& log)
+	{
+		struct Packed
+		{
+			string name;
+			CProgram program;
+			vector<LibraryInstr> code;
+			string names;
+		};
+		vector<Packed> packed(count);
+		CNameTable seen;
+
+		for (int p = 0; p < count; p++)
+		{
+			Packed& entry = packed[p];
+			string path = files[p];
+			size_t slash = path.find_last_of("/\\");
+			string& name = entry.name;
+			name = path.substr(slash == string::npos ? 0 : slash + 1);
+			if (name.size() > 4 && name.compare(name.size() - 4, 4, ".clc") == 0)
+				name.resize(name.size() - 4);
+			for (size_t i = 0; i < name.size(); i++)
+			{
+				if (!isalnum(static_cast<unsigned char>(name[i]))
+					&& name[i] != '_')
+				{
+					log << "Cannot name a program after " << path << endl;
+					return false;
+				}
+				name[i] = toupper(name[i]);
+			}
+			if (name.empty() || seen.find(name.data(), name.size()) >= 0)
+			{
+				log << "Cannot name a program after " << path << endl;
+				return false;
+			}
+			seen.intern(name.data(), name.size());
+			if (!entry.program.read(path.c_str()))
+			{
+				log << "Cannot read " << path << endl;
+				return false;
+			}
+
+			// Compile the lines, numbering the names the code uses for
+			//	this program alone.
+			CNameTable locals;
+			for (size_t i = 0; i < entry.program.size(); i++)
+			{
+				const char* text = entry.program.line(i);
+				Instr instr = { STOP, static_cast<int>(i), 0.0 };
+				if (toupper(text[0]) != 'P')
+					instr = compileLine(text, entry.program.lineLength(i),
+						static_cast<int>(i));
+				LibraryInstr out;
+				memset(&out, 0, sizeof(out));
+				out.op = instr.op;
+				out.line = instr.line;
+				if (usesName(instr.op))
+				{
+					string key = (instr.op == LOADN)
+						? "L" + m_programNames.name(instr.slot)
+						: "G" + m_names.name(instr.slot);
+					size_t before = locals.size();
+					out.slot = locals.intern(key.data(), key.size());
+					if (locals.size() > before)
+						entry.names += key + '\n';
+				}
+				else
+					out.value = instr.value;
+				entry.code.push_back(out);
+				if (instr.op == STOP)
+					break;
+			}
+			log << name << ": " << entry.program.size() << " lines" << endl;
+		}
+
+		// Lay the archive out, then build it in memory and write it once.
+		uint32_t buckets = 2;
+		while (buckets < 2 * static_cast<uint32_t>(count))
+			buckets *= 2;
+		vector<LibraryEntry> entries(count);
+		uint64_t offset = align8(sizeof(LibraryHeader));
+		uint64_t bucketOffset = offset;
+		offset = align8(offset + buckets * sizeof(uint32_t));
+		uint64_t entryOffset = offset;
+		offset += count * sizeof(LibraryEntry);
+		for (int p = 0; p < count; p++)
+		{
+			LibraryEntry& entry = entries[p];
+			memset(&entry, 0, sizeof(entry));
+			entry.nameOffset = offset;
+			entry.nameBytes = static_cast<uint32_t>(packed[p].name.size());
+			entry.hash = libraryHash(packed[p].name.data(),
+				packed[p].name.size());
+			offset += entry.nameBytes;
+			entry.textOffset = offset;
+			entry.textBytes = packed[p].program.textSize();
+			offset = align8(offset + entry.textBytes);
+			entry.codeOffset = offset;
+			entry.codeCount = packed[p].code.size();
+			offset += entry.codeCount * sizeof(LibraryInstr);
+			entry.namesOffset = offset;
+			entry.namesBytes = packed[p].names.size();
+			offset = align8(offset + entry.namesBytes);
+		}
+
+		vector<char> image(offset, 0);
+		LibraryHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, "RPNLIB\0\0", 8);
+		header.version = LIBRARY_VERSION;
+		header.opCount = NUMCMDS;
+		header.opTable = commandTableHash();
+		header.programs = count;
+		header.buckets = buckets;
+		header.bucketOffset = bucketOffset;
+		header.entryOffset = entryOffset;
+		header.totalSize = offset;
+		memcpy(&image[0], &header, sizeof(header));
+		uint32_t* bucket = reinterpret_cast<uint32_t*>(&image[bucketOffset]);
+		for (int p = 0; p < count; p++)
+		{
+			const LibraryEntry& entry = entries[p];
+			uint32_t b = entry.hash & (buckets - 1);
+			while (bucket[b] != 0)
+				b = (b + 1) & (buckets - 1);
+			bucket[b] = p + 1;
+			memcpy(&image[entry.nameOffset], packed[p].name.data(),
+				entry.nameBytes);
+			if (entry.textBytes)
+				memcpy(&image[entry.textOffset], packed[p].program.text(),
+					entry.textBytes);
+			if (entry.codeCount)
+				memcpy(&image[entry.codeOffset], &packed[p].code[0],
+					entry.codeCount * sizeof(LibraryInstr));
+			if (entry.namesBytes)
+				memcpy(&image[entry.namesOffset], packed[p].names.data(),
+					entry.namesBytes);
+		}
+		if (count)
+			memcpy(&image[entryOffset], &entries[0],
+				count * sizeof(LibraryEntry));
+
+		ofstream fileStream(archive, ios::binary);
+		fileStream.write(&image[0], image.size());
+		fileStream.close();
+		if (!fileStream)
+		{
+			log << "Error writing " << archive << endl;
+			return false;
+		}
+		log << "Packed " << count << " programs into " << archive << endl;
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			openLibrary(const char* fileName)
+	//	Description:	Maps a library archive for L:name.  It stays mapped
+	//						until another one is opened.  Its code is
+	//						only used if it was packed with this command
+	//						set.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		const char* fileName -- the archive
+	//	Returns:		bool -- false if it is not a valid archive (no
+	//						library is open then)
+	//	Called by:		loadLibrary(); runBatchMode()
+	//	Calls:			CLibrary::open(); commandTableHash()
+	//	Input:			The archive.
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, checking the
+	//									opcode table once here.
+	//------------------------------------------------------------------------
+	bool CRPNCalc::openLibrary(const char* fileName)
+	{
+		if (!m_library.open(fileName))
+			return false;
+		m_libraryCode = m_library.opCount() == NUMCMDS
+			&& m_library.opTable() == commandTableHash();
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			loadLibrary()
+	//	Description:	LIB: asks the user for a library archive and opens
+	//						it.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			openLibrary()
+	//	Input:			The file name.
+	//	Output:			Prompts for the file name and error messages, if
+	//						applicable.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::loadLibrary()
+	{
+		char fileName[BUFFER_SIZE];
+		cout << "Please enter the name of a program library to open."
+			<< endl;
+		(cin >> fileName).get();
+		if (openLibrary(fileName))
+			cout << "The library holds " << m_library.programs()
+				<< " programs.  Press \"Enter\" to continue.";
+		else
+			cout << "Could not open the library.  Press \"Enter\" to continue.";
+		cin.get();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			loadFromLibrary(int slot)
+	//	Description:	L:name: makes a program from the open library the
+	//						current program.  The source is copied straight
+	//						out of the mapped archive; if the archive was
+	//						packed with this command set, its code is taken
+	//						as well, with its names moved to this
+	//						calculator's slots, so the program runs without
+	//						compiling.  Otherwise it is compiled on its
+	//						first run, like a program loaded with L.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		int slot -- the program name, in m_programNames
+	//	Returns:		None
+	//	Called by:		execute()
+	//	Calls:			CLibrary::find(); CProgram::assign();
+	//						CNameTable::intern()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, matching the
+	//									whole opcode table, not just its size.
+	//------------------------------------------------------------------------
+	void CRPNCalc::loadFromLibrary(int slot)
+	{
+		string name = m_programNames.name(slot);
+		const LibraryEntry* entry = m_library.find(name.data(), name.size());
+		if (!entry)
+		{
+			m_error = true;
+			return;
+		}
+		const char* base = m_library.data();
+		m_program.assign(base + entry->textOffset,
+			static_cast<size_t>(entry->textBytes));
+		m_profile.clear();
+		m_programFile.clear();
+		if (m_watcher.isWatching())
+			m_watcher.stop();
+		if (!m_libraryCode)
+			return;
+
+		vector<int> slots;
+		vector<char> kinds;
+		const char* scan = base + entry->namesOffset;
+		const char* end = scan + entry->namesBytes;
+		while (scan < end)
+		{
+			const char* newline = static_cast<const char*>(
+				memchr(scan, '\n', end - scan));
+			if (!newline || newline - scan < 2)
+				return;
+			kinds.push_back(*scan);
+			if (*scan == 'L')
+				slots.push_back(m_programNames.intern(scan + 1,
+					newline - scan - 1));
+			else
+				slots.push_back(m_names.intern(scan + 1, newline - scan - 1));
+			scan = newline + 1;
+		}
+		if (m_named.size() < m_names.size())
+			m_named.resize(m_names.size(), 0.0);
+
+		const LibraryInstr* code = reinterpret_cast<const LibraryInstr*>(
+			base + entry->codeOffset);
+		vector<Instr> compiled(static_cast<size_t>(entry->codeCount));
+		for (size_t i = 0; i < compiled.size(); i++)
+		{
+			if (code[i].op < 0 || code[i].op >= NUMCMDS
+				|| code[i].line < 0
+				|| static_cast<size_t>(code[i].line) >= m_program.size())
+				return;
+			compiled[i].op = code[i].op;
+			compiled[i].line = code[i].line;
+			if (usesName(code[i].op))
+			{
+				if (code[i].slot < 0
+					|| static_cast<uint64_t>(code[i].slot) >= slots.size()
+					|| (kinds[code[i].slot] == 'L') != (code[i].op == LOADN))
+					return;
+				compiled[i].slot = slots[code[i].slot];
+			}
+			else
+				compiled[i].value = code[i].value;
+		}
+		m_program.code().swap(compiled);
+		m_program.setCompiled();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			commandTableHash()
+	//	Description:	A hash of every keyword and the opcode it compiles
+	//						to, plus the opcodes with no keyword of their
+	//						own, so packed code is only trusted by a
+	//						calculator that numbers the commands the same
+	//						way.  m_map is ordered, so the hash does not
+	//						depend on how the table was built.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		uint32_t -- the hash
+	//	Called by:		packLibrary(); openLibrary()
+	//	Calls:			libraryHash()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	uint32_t CRPNCalc::commandTableHash() const
+	{
+		ostringstream table;
+		for (RPNmap::const_iterator it = m_map.begin(); it != m_map.end();
+			++it)
+			table << it->first << ' ' << it->second << '\n';
+		table << "PUSH " << PUSH << " GETN " << GETN << " SETN " << SETN
+			<< " LOADN " << LOADN << " NUMCMDS " << NUMCMDS << '\n';
+		string text = table.str();
+		return libraryHash(text.data(), text.size());
+	}
+} // end namespace TPUS_CALC
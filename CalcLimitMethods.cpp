@@ -0,0 +1,77 @@
+#include "RPNCalc.h"
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			setLimit(cmd thecmd)
+	//	Description:	LIMI, LIMS and LIMT: "n LIMI" lets a run execute at
+	//						most n instructions, "n LIMS" lets the stack
+	//						hold at most n entries while a program runs and
+	//						"n LIMT" lets a run take at most n milliseconds.
+	//						0 removes the limit.  A run is RUN (with any
+	//						programs it loads or runs in turn), a SOLVE or
+	//						INTEG with all of its evaluations, or a DIFF or
+	//						GRAD.  A run stopped by a limit leaves the stack
+	//						and registers as they were before it and shows
+	//						which limit it hit (see errorMarker()).
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- LIMI, LIMS or LIMT
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			stackTouched()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::setLimit(cmd thecmd)
+	{
+		double n = m_stack.empty() ? NAN : m_stack.front();
+		if (!(n >= 0 && n <= 9007199254740992.0) || n != floor(n))
+		{
+			m_error = true;
+			return;
+		}
+		m_stack.pop_front();
+		stackTouched(m_stack.size());
+		if (thecmd == LIMI)
+			m_limits.setSteps(static_cast<uint64_t>(n));
+		else if (thecmd == LIMS)
+			m_limits.setDepth(static_cast<size_t>(n));
+		else
+			m_limits.setMillis(static_cast<uint64_t>(n));
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			errorMarker()
+	//	Description:	The error marker for the screen and batch results:
+	//						"<<error>>", or "<<error: time limit>>" and so
+	//						on when the last run was stopped by a limit.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		const char* -- the marker
+	//	Called by:		print(); buildScreen(); runBatch()
+	//	Calls:			CRunLimits::lastHit()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	const char* CRPNCalc::errorMarker() const
+	{
+		switch (m_limits.lastHit())
+		{
+		case LIMIT_STEPS:
+			return "<<error: instruction limit>>";
+		case LIMIT_DEPTH:
+			return "<<error: stack limit>>";
+		case LIMIT_TIME:
+			return "<<error: time limit>>";
+		default:
+			return "<<error>>";
+		}
+	}
+} // end namespace TPUS_CALC
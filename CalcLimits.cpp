@@ -0,0 +1,133 @@
+//----------------------------------------------------------------------------
+//    Class:		CRunLimits
+//
+//    File:       CalcLimits.cpp
+//
+//    Description: This file contains the function definitions for
+//					CRunLimits
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcLimits.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CRunLimits()
+	//	Description:	No limits, and no run under way.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CRunLimits::CRunLimits()
+		: m_steps(0), m_depth(0), m_millis(0), m_lastHit(LIMIT_NONE)
+	{
+		reset();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			start()
+	//	Description:	Begins a limited run: the budget, depth and deadline
+	//						are taken from the limits as they are now.
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		CRPNCalc::runProgram(); CRPNCalc::solve();
+	//						CRPNCalc::differentiate()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRunLimits::start()
+	{
+		m_running = true;
+		m_remaining = m_steps ? m_steps : UINT64_MAX;
+		m_countdown = 0;
+		m_maxDepth = m_depth ? m_depth : SIZE_MAX;
+		m_timed = (m_millis != 0);
+		if (m_timed)
+			m_deadline = chrono::steady_clock::now()
+				+ chrono::milliseconds(m_millis);
+		m_hit = LIMIT_NONE;
+		m_lastHit = LIMIT_NONE;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			finish(size_t depth)
+	//	Description:	Ends the run, checking the depth the last
+	//						instruction left.
+	//	Programmers:	David Landry
+	//	Parameters:		size_t depth -- the stack's depth
+	//	Returns:		bool -- true if a limit stopped the run
+	//	Called by:		CRPNCalc::runProgram(); CRPNCalc::solve();
+	//						CRPNCalc::differentiate()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CRunLimits::finish(size_t depth)
+	{
+		if (m_hit == LIMIT_NONE && depth > m_maxDepth)
+			m_hit = LIMIT_DEPTH;
+		m_lastHit = m_hit;
+		reset();
+		return m_lastHit != LIMIT_NONE;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			checkpoint(size_t depth)
+	//	Description:	Called when the slice runs out or the stack is too
+	//						deep: records the limit hit, if any, or hands
+	//						out the next slice of the budget (and charges
+	//						this instruction to it).
+	//	Programmers:	David Landry
+	//	Parameters:		size_t depth -- the stack's depth
+	//	Returns:		bool -- true if the run must stop
+	//	Called by:		exceeded()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CRunLimits::checkpoint(size_t depth)
+	{
+		if (m_hit == LIMIT_NONE)
+		{
+			if (depth > m_maxDepth)
+				m_hit = LIMIT_DEPTH;
+			else if (m_remaining == 0)
+				m_hit = LIMIT_STEPS;
+			else if (m_timed && chrono::steady_clock::now() >= m_deadline)
+				m_hit = LIMIT_TIME;
+		}
+		if (m_hit != LIMIT_NONE)
+		{
+			m_countdown = 0;
+			return true;
+		}
+		m_countdown = static_cast<uint32_t>(
+			min<uint64_t>(CHECK_INTERVAL, m_remaining));
+		m_remaining -= m_countdown;
+		m_countdown--;
+		return false;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			reset()
+	//	Description:	No run under way: exceeded() never stops anything.
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		CRunLimits(); finish()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRunLimits::reset()
+	{
+		m_running = false;
+		m_remaining = UINT64_MAX;
+		m_countdown = 0;
+		m_maxDepth = SIZE_MAX;
+		m_timed = false;
+		m_hit = LIMIT_NONE;
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,132 @@
+//----------------------------------------------------------------------------
+//    File:		CalcLimits.h
+//
+//    Class:	CRunLimits
+//----------------------------------------------------------------------------
+#ifndef CALCLIMITS_H
+#define CALCLIMITS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+//----------------------------------------------------------------------------
+//
+//    Title:		CRunLimits Class
+//
+//    Description:	Limits on one run of a program: how many instructions
+//						it may execute, how deep the stack may grow and
+//						how many milliseconds it may take.  0 means no
+//						limit, and all three start that way.
+//
+//						The interpreter calls exceeded() before each
+//						instruction.  That only counts down and compares
+//						the depth; every CHECK_INTERVAL instructions (or
+//						fewer, as the budget runs out) it calls
+//						checkpoint(), which charges the slice to the
+//						budget and reads the clock.  So the budget and
+//						the depth are exact, and the time limit is
+//						noticed within CHECK_INTERVAL instructions of
+//						passing.  Once a limit is hit exceeded() stays
+//						true until the run finishes, so nested runs
+//						unwind too.
+//
+//						Limits set while a program runs apply from the
+//						next run.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  enum LimitHit -- which limit stopped a run, if any
+//
+//	  class CRunLimits:
+//
+//	  Properties:
+//		uint64_t m_steps -- instruction budget
+//		size_t m_depth -- largest stack allowed
+//		uint64_t m_millis -- time allowed
+//		bool m_running -- a limited run is under way
+//		uint64_t m_remaining -- budget not yet handed out in slices
+//		uint32_t m_countdown -- instructions left in the current slice
+//		size_t m_maxDepth -- m_depth, or no limit, for this run
+//		bool m_timed -- this run has a deadline
+//		steady_clock::time_point m_deadline -- when this run must stop
+//		LimitHit m_hit -- what stopped this run
+//		LimitHit m_lastHit -- what stopped the last run
+//
+//	  Methods:
+//
+//		inline:
+//			bool active() const -- some limit is set
+//			bool running() const
+//			bool exceeded(size_t depth)
+//			LimitHit lastHit() const
+//			void clearHit()
+//			uint64_t steps() const; size_t depth() const;
+//			uint64_t millis() const
+//			void setSteps(uint64_t steps); void setDepth(size_t depth);
+//			void setMillis(uint64_t millis)
+//
+//		non-inline:
+//			CRunLimits();
+//			void start();
+//			bool finish(size_t depth);
+//		private:
+//			bool checkpoint(size_t depth);
+//			void reset();
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	enum LimitHit {LIMIT_NONE, LIMIT_STEPS, LIMIT_DEPTH, LIMIT_TIME};
+
+	class CRunLimits
+	{
+	public:
+		static const uint32_t CHECK_INTERVAL = 1024;
+
+		CRunLimits();
+		void start();
+		bool finish(size_t depth);
+
+		bool active() const { return m_steps || m_depth || m_millis; }
+		bool running() const { return m_running; }
+		// Called before each instruction with the stack's depth.
+		bool exceeded(size_t depth)
+		{
+			if (m_countdown == 0 || depth > m_maxDepth)
+				return checkpoint(depth);
+			m_countdown--;
+			return false;
+		}
+		LimitHit lastHit() const { return m_lastHit; }
+		void clearHit() { m_lastHit = LIMIT_NONE; }
+		uint64_t steps() const { return m_steps; }
+		size_t depth() const { return m_depth; }
+		uint64_t millis() const { return m_millis; }
+		void setSteps(uint64_t steps) { m_steps = steps; }
+		void setDepth(size_t depth) { m_depth = depth; }
+		void setMillis(uint64_t millis) { m_millis = millis; }
+
+	private:
+		bool checkpoint(size_t depth);
+		void reset();
+
+		uint64_t m_steps;
+		size_t m_depth;
+		uint64_t m_millis;
+		bool m_running;
+		uint64_t m_remaining;
+		uint32_t m_countdown;
+		size_t m_maxDepth;
+		bool m_timed;
+		std::chrono::steady_clock::time_point m_deadline;
+		LimitHit m_hit;
+		LimitHit m_lastHit;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,86 @@
+//----------------------------------------------------------------------------
+//    Class:		CMappedFile
+//
+//    File:       CalcMappedFile.cpp
+//
+//    Description: This file contains the function definitions for
+//					CMappedFile
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcMappedFile.h"
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CMappedFile(const char* fileName)
+	//	Description:	Maps (or reads) the file.  An empty or missing file
+	//						leaves the object closed; check isOpen().
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CMappedFile::CMappedFile(const char* fileName) : m_data(0), m_size(0)
+	{
+#ifdef _WIN32
+		ifstream fileStream(fileName, ios::binary);
+		m_copy.assign(istreambuf_iterator<char>(fileStream),
+			istreambuf_iterator<char>());
+		if (!m_copy.empty())
+		{
+			m_data = &m_copy[0];
+			m_size = m_copy.size();
+		}
+#else
+		int fd = open(fileName, O_RDONLY);
+		struct stat info;
+		if (fd < 0)
+			return;
+		if (fstat(fd, &info) == 0 && info.st_size > 0)
+		{
+			int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+			flags |= MAP_POPULATE;		// fault the pages in up front, in bulk
+#endif
+			void* mapping = mmap(0, static_cast<size_t>(info.st_size),
+				PROT_READ, flags, fd, 0);
+			if (mapping != MAP_FAILED)
+			{
+				m_data = static_cast<const char*>(mapping);
+				m_size = static_cast<size_t>(info.st_size);
+				posix_madvise(mapping, m_size, POSIX_MADV_SEQUENTIAL);
+			}
+		}
+		close(fd);
+#endif
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			~CMappedFile()
+	//	Description:	Releases the mapping.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CMappedFile::~CMappedFile()
+	{
+#ifndef _WIN32
+		if (m_data)
+			munmap(const_cast<char*>(m_data), m_size);
+#endif
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,68 @@
+//----------------------------------------------------------------------------
+//    File:		CalcMappedFile.h
+//
+//    Class:	CMappedFile
+//----------------------------------------------------------------------------
+#ifndef CALCMAPPEDFILE_H
+#define CALCMAPPEDFILE_H
+
+#include <cstddef>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		CMappedFile Class
+//
+//    Description:	A whole file, read-only, as one block of memory.  On
+//						POSIX systems the file is memory-mapped, so its
+//						pages are read on demand straight from the page
+//						cache; elsewhere it is read into a buffer.  The
+//						mapping is released when the object goes away.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  class CMappedFile:
+//
+//	  Properties:
+//		const char* m_data -- the file contents (null if not open)
+//		size_t m_size -- the file size
+//		vector<char> m_copy -- the contents, where mmap is not used
+//
+//	  Methods:
+//
+//		inline:
+//			bool isOpen() const
+//			const char* data() const
+//			size_t size() const
+//
+//		non-inline:
+//			CMappedFile(const char* fileName);
+//			~CMappedFile();
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	class CMappedFile
+	{
+	public:
+		explicit CMappedFile(const char* fileName);
+		~CMappedFile();
+		bool isOpen() const { return m_data != 0; }
+		const char* data() const { return m_data; }
+		size_t size() const { return m_size; }
+
+	private:
+		CMappedFile(const CMappedFile&);				// not copyable
+		CMappedFile& operator=(const CMappedFile&);
+
+		const char* m_data;
+		size_t m_size;
+		std::vector<char> m_copy;
+	};
+} // end namespace TPUS_CALC
+
+#endif
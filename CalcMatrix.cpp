@@ -0,0 +1,306 @@
+//----------------------------------------------------------------------------
+//    Class:		CMatrixTable
+//
+//    File:       CalcMatrix.cpp
+//
+//    Description: This file contains the matrix kernels and the function
+//					definitions for CMatrixTable
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcMatrix.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	const size_t MUL_BLOCK = 64;		// 64 x 64 doubles = 32 KB per block
+	const size_t TRANSPOSE_BLOCK = 32;
+
+	//------------------------------------------------------------------------
+	//	Function:		matrixAdd(const CMatrix& a, const CMatrix& b,
+	//						double sign, CMatrix& c)
+	//	Description:	c = a + sign * b; the shapes must match.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void matrixAdd(const CMatrix& a, const CMatrix& b, double sign,
+		CMatrix& c)
+	{
+		c = CMatrix(a.rows, a.cols);
+		const double* pa = a.data.data();
+		const double* pb = b.data.data();
+		double* pc = c.data.data();
+		for (size_t i = 0; i < c.data.size(); i++)
+			pc[i] = pa[i] + sign * pb[i];
+	}
+
+	//------------------------------------------------------------------------
+	//	Function:		matrixMultiply(const CMatrix& a, const CMatrix& b,
+	//						CMatrix& c)
+	//	Description:	c = a * b, with a.cols == b.rows.  The i, k and j
+	//						loops are blocked so each block of a, b and c
+	//						is reused from cache; the innermost loop runs
+	//						along a row of b and c with unit stride and no
+	//						dependency between iterations, so it is
+	//						vectorized.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void matrixMultiply(const CMatrix& a, const CMatrix& b, CMatrix& c)
+	{
+		size_t n = a.rows;
+		size_t inner = a.cols;
+		size_t m = b.cols;
+
+		c = CMatrix(n, m);
+		for (size_t ii = 0; ii < n; ii += MUL_BLOCK)
+			for (size_t kk = 0; kk < inner; kk += MUL_BLOCK)
+				for (size_t jj = 0; jj < m; jj += MUL_BLOCK)
+				{
+					size_t iEnd = min(ii + MUL_BLOCK, n);
+					size_t kEnd = min(kk + MUL_BLOCK, inner);
+					size_t jEnd = min(jj + MUL_BLOCK, m);
+					for (size_t i = ii; i < iEnd; i++)
+					{
+						double* cRow = &c.data[i * m];
+						for (size_t k = kk; k < kEnd; k++)
+						{
+							double aik = a.data[i * inner + k];
+							const double* bRow = &b.data[k * m];
+							for (size_t j = jj; j < jEnd; j++)
+								cRow[j] += aik * bRow[j];
+						}
+					}
+				}
+	}
+
+	//------------------------------------------------------------------------
+	//	Function:		matrixTranspose(const CMatrix& a, CMatrix& t)
+	//	Description:	t = a transposed, a tile at a time so both the reads
+	//						and the writes stay within a few cache lines.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void matrixTranspose(const CMatrix& a, CMatrix& t)
+	{
+		t = CMatrix(a.cols, a.rows);
+		for (size_t ii = 0; ii < a.rows; ii += TRANSPOSE_BLOCK)
+			for (size_t jj = 0; jj < a.cols; jj += TRANSPOSE_BLOCK)
+			{
+				size_t iEnd = min(ii + TRANSPOSE_BLOCK, a.rows);
+				size_t jEnd = min(jj + TRANSPOSE_BLOCK, a.cols);
+				for (size_t i = ii; i < iEnd; i++)
+					for (size_t j = jj; j < jEnd; j++)
+						t.data[j * a.rows + i] = a.data[i * a.cols + j];
+			}
+	}
+
+	//------------------------------------------------------------------------
+	//	Function:		luDecompose(CMatrix& lu, vector<size_t>& perm,
+	//						double& sign)
+	//	Description:	Replaces the square matrix lu with its LU factors
+	//						(L below the diagonal with an implied unit
+	//						diagonal, U on and above it), choosing the
+	//						largest pivot in each column.  perm receives the
+	//						row order and sign the permutation's parity.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- false if the matrix is singular
+	//	Called by:		matrixSolve(); matrixDeterminant()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	static bool luDecompose(CMatrix& lu, vector<size_t>& perm, double& sign)
+	{
+		size_t n = lu.rows;
+
+		perm.resize(n);
+		for (size_t i = 0; i < n; i++)
+			perm[i] = i;
+		sign = 1.0;
+		for (size_t k = 0; k < n; k++)
+		{
+			size_t pivot = k;
+			for (size_t i = k + 1; i < n; i++)
+				if (fabs(lu.at(i, k)) > fabs(lu.at(pivot, k)))
+					pivot = i;
+			if (lu.at(pivot, k) == 0.0)
+				return false;
+			if (pivot != k)
+			{
+				swap_ranges(&lu.data[k * n], &lu.data[k * n] + n,
+					&lu.data[pivot * n]);
+				swap(perm[k], perm[pivot]);
+				sign = -sign;
+			}
+			const double* kRow = &lu.data[k * n];
+			for (size_t i = k + 1; i < n; i++)
+			{
+				double* iRow = &lu.data[i * n];
+				double factor = iRow[k] / kRow[k];
+				iRow[k] = factor;
+				for (size_t j = k + 1; j < n; j++)
+					iRow[j] -= factor * kRow[j];
+			}
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Function:		matrixSolve(const CMatrix& a, const CMatrix& b,
+	//						CMatrix& x)
+	//	Description:	Solves a * x = b for square a, with any number of
+	//						columns in b.  Substitution works on whole rows
+	//						of x at a time, with unit stride.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- false if a is singular
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool matrixSolve(const CMatrix& a, const CMatrix& b, CMatrix& x)
+	{
+		CMatrix lu = a;
+		vector<size_t> perm;
+		double sign;
+		size_t n = a.rows;
+		size_t m = b.cols;
+
+		if (!luDecompose(lu, perm, sign))
+			return false;
+		x = CMatrix(n, m);
+		for (size_t i = 0; i < n; i++)
+			copy(&b.data[perm[i] * m], &b.data[perm[i] * m] + m,
+				&x.data[i * m]);
+		for (size_t i = 1; i < n; i++)			// L y = P b
+			for (size_t k = 0; k < i; k++)
+			{
+				double factor = lu.at(i, k);
+				for (size_t j = 0; j < m; j++)
+					x.data[i * m + j] -= factor * x.data[k * m + j];
+			}
+		for (size_t i = n; i-- > 0; )			// U x = y
+		{
+			for (size_t k = i + 1; k < n; k++)
+			{
+				double factor = lu.at(i, k);
+				for (size_t j = 0; j < m; j++)
+					x.data[i * m + j] -= factor * x.data[k * m + j];
+			}
+			for (size_t j = 0; j < m; j++)
+				x.data[i * m + j] /= lu.at(i, i);
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Function:		matrixDeterminant(const CMatrix& a)
+	//	Description:	Determinant of a square matrix, from its LU factors.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	double matrixDeterminant(const CMatrix& a)
+	{
+		CMatrix lu = a;
+		vector<size_t> perm;
+		double det;
+
+		if (!luDecompose(lu, perm, det))
+			return 0.0;
+		for (size_t i = 0; i < a.rows; i++)
+			det *= lu.at(i, i);
+		return det;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			CMatrixTable()
+	//	Description:	Creates an empty table.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CMatrixTable::CMatrixTable() : m_liveCount(0)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			add(CMatrix& matrix)
+	//	Description:	Takes over a new matrix (matrix is left empty).
+	//	Programmers:	David Landry
+	//	Returns:		double -- the boxed handle to push
+	//	Called by:		CRPNCalc::pushMatrix()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	double CMatrixTable::add(CMatrix& matrix)
+	{
+		uint32_t index;
+		if (m_free.empty())
+		{
+			index = static_cast<uint32_t>(m_matrices.size());
+			m_matrices.push_back(CMatrix());
+			m_live.push_back(false);
+			m_marked.push_back(false);
+		}
+		else
+		{
+			index = m_free.back();
+			m_free.pop_back();
+		}
+		m_matrices[index].rows = matrix.rows;
+		m_matrices[index].cols = matrix.cols;
+		m_matrices[index].data.swap(matrix.data);
+		m_live[index] = true;
+		m_liveCount++;
+		return box(BOX_MATRIX, index);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			get(double value)
+	//	Description:	Looks up the matrix a stack value refers to.
+	//	Programmers:	David Landry
+	//	Returns:		const CMatrix* -- null if value is not a matrix
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	const CMatrix* CMatrixTable::get(double value) const
+	{
+		if (!isBoxed(value) || boxKind(value) != BOX_MATRIX)
+			return 0;
+		uint32_t index = boxIndex(value);
+		if (index >= m_matrices.size() || !m_live[index])
+			return 0;
+		return &m_matrices[index];
+	}
+
+	//------------------------------------------------------------------------
+	//	Methods:		mark(double value), sweep()
+	//	Description:	Garbage collection: mark every value that can still
+	//						be reached, then sweep() frees the matrices that
+	//						were not marked.
+	//	Programmers:	David Landry
+	//	Called by:		CRPNCalc::collectValues()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CMatrixTable::mark(double value)
+	{
+		if (get(value))
+			m_marked[boxIndex(value)] = true;
+	}
+
+	void CMatrixTable::sweep()
+	{
+		for (uint32_t i = 0; i < m_matrices.size(); i++)
+		{
+			if (m_live[i] && !m_marked[i])
+			{
+				vector<double>().swap(m_matrices[i].data);
+				m_live[i] = false;
+				m_liveCount--;
+				m_free.push_back(i);
+			}
+			m_marked[i] = false;
+		}
+	}
+} // end namespace TPUS_CALC
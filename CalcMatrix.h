@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------
+//    File:		CalcMatrix.h
+//
+//    Class:	CMatrix, CMatrixTable
+//----------------------------------------------------------------------------
+#ifndef CALCMATRIX_H
+#define CALCMATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		Matrix values
+//
+//    Description:	The stack only holds doubles, so a matrix sits on it as
+//						a boxed handle: a quiet NaN whose top 16 bits are
+//						BOX_TAG, with the kind of value in bits 32-47 and a
+//						table index in the low 32 bits.  Arithmetic never
+//						produces that bit pattern by itself (the machine's
+//						default NaN has a different top half), so a
+//						handle can be told from a number with one compare.
+//						The matrices themselves live in a CMatrixTable and
+//						never change once made; unreferenced ones are
+//						freed by mark and sweep.
+//
+//						The kernels work on row-major storage.  multiply()
+//						is blocked so the working set of each block stays
+//						in cache, with a unit-stride inner loop the
+//						compiler vectorizes; solve() and determinant() use
+//						LU decomposition with partial pivoting.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  struct CMatrix:
+//		size_t rows, cols -- the shape
+//		vector<double> data -- the entries, row by row
+//
+//	  class CMatrixTable:
+//
+//	  Properties:
+//		vector<CMatrix> m_matrices -- matrices by index
+//		vector<bool> m_live -- index is in use
+//		vector<bool> m_marked -- reached during a collection
+//		vector<uint32_t> m_free -- indexes free for reuse
+//		size_t m_liveCount -- indexes in use
+//
+//	  Methods:
+//
+//		inline:
+//			size_t liveCount() const
+//			uint32_t slots() const
+//
+//		non-inline:
+//			CMatrixTable();
+//			double add(CMatrix& matrix);
+//			const CMatrix* get(double value) const;
+//			void mark(double value);
+//			void sweep();
+//
+//	  Functions:
+//		bool isBoxed(double value), uint32_t boxKind(double value),
+//		uint32_t boxIndex(double value), double box(uint32_t kind,
+//		uint32_t index) -- handle encoding
+//		void matrixAdd(const CMatrix& a, const CMatrix& b, double sign,
+//			CMatrix& c) -- c = a + sign * b
+//		void matrixMultiply(const CMatrix& a, const CMatrix& b, CMatrix& c)
+//		void matrixTranspose(const CMatrix& a, CMatrix& t)
+//		bool matrixSolve(const CMatrix& a, const CMatrix& b, CMatrix& x)
+//		double matrixDeterminant(const CMatrix& a)
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	const uint64_t BOX_TAG = 0x7FFC000000000000ULL;
+	const uint64_t BOX_TAG_MASK = 0xFFFF000000000000ULL;
+	const uint32_t BOX_MATRIX = 1;		// boxed value kinds
+
+	inline bool isBoxed(double value)
+	{
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return (bits & BOX_TAG_MASK) == BOX_TAG;
+	}
+
+	inline uint32_t boxKind(double value)
+	{
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return static_cast<uint32_t>(bits >> 32) & 0xFFFF;
+	}
+
+	inline uint32_t boxIndex(double value)
+	{
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return static_cast<uint32_t>(bits);
+	}
+
+	inline double box(uint32_t kind, uint32_t index)
+	{
+		uint64_t bits = BOX_TAG | (static_cast<uint64_t>(kind) << 32) | index;
+		double value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	struct CMatrix
+	{
+		size_t rows;
+		size_t cols;
+		std::vector<double> data;
+
+		CMatrix() : rows(0), cols(0) {}
+		CMatrix(size_t r, size_t c) : rows(r), cols(c), data(r * c) {}
+		double& at(size_t r, size_t c) { return data[r * cols + c]; }
+		double at(size_t r, size_t c) const { return data[r * cols + c]; }
+	};
+
+	void matrixAdd(const CMatrix& a, const CMatrix& b, double sign,
+		CMatrix& c);
+	void matrixMultiply(const CMatrix& a, const CMatrix& b, CMatrix& c);
+	void matrixTranspose(const CMatrix& a, CMatrix& t);
+	bool matrixSolve(const CMatrix& a, const CMatrix& b, CMatrix& x);
+	double matrixDeterminant(const CMatrix& a);
+
+	class CMatrixTable
+	{
+	public:
+		CMatrixTable();
+		double add(CMatrix& matrix);
+		const CMatrix* get(double value) const;
+		void mark(double value);
+		void sweep();
+		size_t liveCount() const { return m_liveCount; }
+		uint32_t slots() const
+			{ return static_cast<uint32_t>(m_matrices.size()); }
+
+	private:
+		std::vector<CMatrix> m_matrices;
+		std::vector<bool> m_live;
+		std::vector<bool> m_marked;
+		std::vector<uint32_t> m_free;
+		size_t m_liveCount;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,331 @@
+#include "RPNCalc.h"
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			makeMatrix()
+	//	Description:	MAT: pops the column count c and row count r, then
+	//						r * c entries, and pushes them as one r x c
+	//						matrix.  The entries are taken in the order they
+	//						were entered, row by row, so "1 2 3 4 2 2 MAT"
+	//						is [1 2; 3 4].
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			pushMatrix(); stackTouched()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::makeMatrix()
+	{
+		if (m_stack.size() < 2)
+		{
+			m_error = true;
+			return;
+		}
+		double cols = m_stack[0];
+		double rows = m_stack[1];
+		if (!(rows >= 1 && cols >= 1 && rows == floor(rows)
+			&& cols == floor(cols) && rows * cols + 2 <= m_stack.size()))
+		{
+			m_error = true;
+			return;
+		}
+		CMatrix matrix(static_cast<size_t>(rows), static_cast<size_t>(cols));
+		size_t count = matrix.data.size();
+		for (size_t i = 0; i < count; i++)
+		{
+			double entry = m_stack[count + 1 - i];
+			if (isBoxed(entry))
+			{
+				m_error = true;
+				return;
+			}
+			matrix.data[i] = entry;
+		}
+		m_stack.pop_front(count + 2);
+		stackTouched(m_stack.size());
+		pushMatrix(matrix);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			unpackMatrix()
+	//	Description:	MUNPK: the reverse of MAT.  Replaces the matrix on
+	//						top with its entries, row by row, then its row
+	//						and column counts.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			stackTouched()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::unpackMatrix()
+	{
+		const CMatrix* matrix = m_stack.empty() ? 0
+			: m_matrices.get(m_stack.front());
+		if (!matrix)
+		{
+			m_error = true;
+			return;
+		}
+		m_stack.pop_front();
+		stackTouched(m_stack.size());
+		m_stack.reserve(matrix->data.size() + 2);
+		for (size_t i = 0; i < matrix->data.size(); i++)
+			m_stack.push_front(matrix->data[i]);
+		m_stack.push_front(static_cast<double>(matrix->rows));
+		m_stack.push_front(static_cast<double>(matrix->cols));
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			matrixOp(cmd thecmd)
+	//	Description:	The matrix commands other than MAT and MUNPK:
+	//						MT transposes the matrix on top, MDET replaces a
+	//						square matrix with its determinant, and MSOLVE
+	//						pops b and then A and pushes x with A x = b.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- MTRANS, MDET or MSOLVE
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			matrixTranspose(); matrixDeterminant();
+	//						matrixSolve(); pushMatrix()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::matrixOp(cmd thecmd)
+	{
+		size_t operands = (thecmd == MSOLVE) ? 2 : 1;
+		const CMatrix* top = m_stack.size() < operands ? 0
+			: m_matrices.get(m_stack[0]);
+		const CMatrix* below = (operands == 2 && top)
+			? m_matrices.get(m_stack[1]) : 0;
+		CMatrix result;
+		double det = 0.0;
+
+		if (!top || (operands == 2 && !below))
+		{
+			m_error = true;
+			return;
+		}
+		switch (thecmd)
+		{
+		case MTRANS:
+			matrixTranspose(*top, result);
+			break;
+		case MDET:
+			if (top->rows != top->cols)
+			{
+				m_error = true;
+				return;
+			}
+			det = matrixDeterminant(*top);
+			break;
+		default:
+			if (below->rows != below->cols || below->rows != top->rows
+				|| !matrixSolve(*below, *top, result))
+			{
+				m_error = true;
+				return;
+			}
+			break;
+		}
+		m_stack.pop_front(operands);
+		stackTouched(m_stack.size());
+		if (thecmd == MDET)
+			m_stack.push_front(det);
+		else
+			pushMatrix(result);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			matrixArith(cmd thecmd)
+	//	Description:	+, - and * of two matrices.  add(), subtract() and
+	//						multiply() try this first; it does nothing
+	//						unless both operands are matrices.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- ADD, SUB or MULT
+	//	Returns:		bool -- true if the operands were matrices (the
+	//						result, or the error flag, is then set)
+	//	Called by:		add(); subtract(); multiply()
+	//	Calls:			matrixAdd(); matrixMultiply(); pushMatrix()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CRPNCalc::matrixArith(cmd thecmd)
+	{
+		if (m_stack.size() < 2)
+			return false;
+		const CMatrix* b = m_matrices.get(m_stack[0]);
+		const CMatrix* a = m_matrices.get(m_stack[1]);
+		CMatrix result;
+		if (!a || !b)
+			return false;
+		if (thecmd == MULT ? a->cols != b->rows
+			: (a->rows != b->rows || a->cols != b->cols))
+		{
+			m_error = true;
+			return true;
+		}
+		if (thecmd == MULT)
+			matrixMultiply(*a, *b, result);
+		else
+			matrixAdd(*a, *b, (thecmd == SUB) ? -1.0 : 1.0, result);
+		m_stack.pop_front(2);
+		stackTouched(m_stack.size());
+		pushMatrix(result);
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			pushMatrix(CMatrix& matrix)
+	//	Description:	Stores a new matrix and pushes its handle.  Once
+	//						the table holds twice as many matrices as were
+	//						alive after the last collection, the unreachable
+	//						ones are collected first.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		CMatrix& matrix -- taken over (left empty)
+	//	Returns:		None
+	//	Called by:		makeMatrix(); matrixOp(); matrixArith()
+	//	Calls:			collectValues(); CMatrixTable::add()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::pushMatrix(CMatrix& matrix)
+	{
+		if (m_matrices.liveCount() >= m_matrixLimit)
+		{
+			collectValues();
+			m_matrixLimit = max<size_t>(MATRIX_GC_MIN,
+				2 * m_matrices.liveCount());
+		}
+		m_stack.push_front(m_matrices.add(matrix));
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			collectValues()
+	//	Description:	Frees every matrix and complex value that nothing
+	//						refers to any more.  A handle can be on the
+	//						stack, in a numbered or named register, or in
+	//						any undo, redo or named snapshot.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		pushMatrix(); pushComplex(); saveState()
+	//	Calls:			markValue(); markSnapshot(); CMatrixTable::sweep();
+	//						CComplexTable::sweep()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL version 1.1, collecting complex values
+	//									too (was collectMatrices())
+	//------------------------------------------------------------------------
+	void CRPNCalc::collectValues()
+	{
+		for (size_t i = 0; i < m_stack.size(); i++)
+			markValue(m_stack[i]);
+		for (size_t i = 0; i < m_scratch.size(); i++)	// during SOLVE/INTEG
+			markValue(m_scratch[i]);
+		for (size_t i = 0; i < NUMREGS; i++)
+			markValue(m_registers[i]);
+		for (size_t i = 0; i < m_named.size(); i++)
+			markValue(m_named[i]);
+		markSnapshot(m_image);
+		for (size_t i = 0; i < m_undo.size(); i++)
+			markSnapshot(m_undo[i]);
+		for (size_t i = 0; i < m_redo.size(); i++)
+			markSnapshot(m_redo[i]);
+		for (map<string, CSnapshot>::iterator it = m_snapshots.begin();
+			it != m_snapshots.end(); it++)
+			markSnapshot(it->second);
+		m_matrices.sweep();
+		m_complexes.sweep();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			markSnapshot(const CSnapshot& image)
+	//	Description:	Marks the boxed values a snapshot refers to.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		const CSnapshot& image -- the snapshot
+	//	Returns:		None
+	//	Called by:		collectValues()
+	//	Calls:			markValue()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::markSnapshot(const CSnapshot& image)
+	{
+		for (const PNode* node = image.stack.head(); node; node = node->next)
+			markValue(node->value);
+		for (size_t i = 0; i < image.registers->size(); i++)
+			markValue((*image.registers)[i]);
+		for (size_t i = 0; i < image.named->size(); i++)
+			markValue((*image.named)[i]);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			printValue(ostream& ostr, double value)
+	//	Description:	Prints a stack value: the number, a complex value
+	//						as a+bi, or the shape of a matrix.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		ostream& ostr -- where to print
+	//					double value -- the value
+	//	Returns:		None
+	//	Called by:		print(); buildScreen(); runBatch()
+	//	Calls:			CMatrixTable::get(); CComplexTable::get();
+	//						CNumberFormat::write()
+	//	Input:			None
+	//	Output:			The value.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL version 1.1, printing complex values
+	//					10/19/2026	DL version 1.2, printing numbers in the
+	//									display format (STD, FIX, SCI, ENG)
+	//------------------------------------------------------------------------
+	void CRPNCalc::printValue(ostream& ostr, double value) const
+	{
+		const CMatrix* matrix = m_matrices.get(value);
+		double re, im;
+		if (matrix)
+			ostr << "[" << matrix->rows << "x" << matrix->cols << " matrix]";
+		else if (m_complexes.get(value, re, im))
+		{
+			m_format.write(ostr, re);
+			ostr.put(signbit(im) ? '-' : '+');
+			m_format.write(ostr, fabs(im));
+			ostr.put('i');
+		}
+		else
+			m_format.write(ostr, value);
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,122 @@
+//----------------------------------------------------------------------------
+//    Class:		CNameTable
+//
+//    File:       CalcNames.cpp
+//
+//    Description: This file contains the function definitions for
+//					CNameTable
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcNames.h"
+#include <cstring>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CNameTable()
+	//	Description:	Creates an empty table with a few buckets.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CNameTable::CNameTable() : m_index(16, -1)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			find(const char* text, size_t len)
+	//	Description:	Looks a name up.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* text, size_t len -- the name
+	//	Returns:		int -- its slot, or -1 if it has none
+	//	Called by:		intern(); CRPNCalc::loadState()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	int CNameTable::find(const char* text, size_t len) const
+	{
+		unsigned h = hash(text, len);
+		size_t mask = m_index.size() - 1;
+		for (size_t i = h & mask; m_index[i] >= 0; i = (i + 1) & mask)
+		{
+			int slot = m_index[i];
+			if (m_hashes[slot] == h && m_names[slot].size() == len
+				&& memcmp(m_names[slot].data(), text, len) == 0)
+				return slot;
+		}
+		return -1;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			intern(const char* text, size_t len)
+	//	Description:	Looks a name up, giving it the next slot if it is
+	//						new.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* text, size_t len -- the name
+	//	Returns:		int -- its slot
+	//	Called by:		CRPNCalc::compileLine(); CRPNCalc::loadState()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	int CNameTable::intern(const char* text, size_t len)
+	{
+		int slot = find(text, len);
+		if (slot >= 0)
+			return slot;
+		if ((m_names.size() + 1) * 2 > m_index.size())
+			grow();
+		slot = static_cast<int>(m_names.size());
+		m_names.push_back(string(text, len));
+		m_hashes.push_back(hash(text, len));
+		size_t mask = m_index.size() - 1;
+		size_t i = m_hashes[slot] & mask;
+		while (m_index[i] >= 0)
+			i = (i + 1) & mask;
+		m_index[i] = slot;
+		return slot;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			hash(const char* text, size_t len)
+	//	Description:	FNV-1a hash of a name.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	unsigned CNameTable::hash(const char* text, size_t len)
+	{
+		unsigned h = 2166136261u;
+		for (size_t i = 0; i < len; i++)
+		{
+			h ^= static_cast<unsigned char>(text[i]);
+			h *= 16777619u;
+		}
+		return h;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			grow()
+	//	Description:	Doubles the bucket array and reinserts every slot
+	//						from its stored hash.
+	//	Programmers:	David Landry
+	//	Called by:		intern()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CNameTable::grow()
+	{
+		vector<int> index(m_index.size() * 2, -1);
+		size_t mask = index.size() - 1;
+		for (size_t slot = 0; slot < m_names.size(); slot++)
+		{
+			size_t i = m_hashes[slot] & mask;
+			while (index[i] >= 0)
+				i = (i + 1) & mask;
+			index[i] = static_cast<int>(slot);
+		}
+		m_index.swap(index);
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,74 @@
+//----------------------------------------------------------------------------
+//    File:		CalcNames.h
+//
+//    Class:	CNameTable
+//----------------------------------------------------------------------------
+#ifndef CALCNAMES_H
+#define CALCNAMES_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		CNameTable Class
+//
+//    Description:	Maps register names to slot numbers.  Slots are handed
+//						out in order (0, 1, 2, ...) and never reused, so a
+//						slot stays valid in compiled code for the life of
+//						the table.  Lookup is a flat open-addressing hash
+//						table with linear probing; it is only consulted
+//						when a line is compiled, never while it runs.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  class CNameTable:
+//
+//	  Properties:
+//		vector<int> m_index -- hash buckets holding slot numbers (-1 empty);
+//			the size is a power of two kept at least twice size()
+//		vector<unsigned> m_hashes -- hash of each slot's name
+//		vector<string> m_names -- name of each slot
+//
+//	  Methods:
+//
+//		inline:
+//			size_t size() const
+//			const string& name(int slot) const
+//
+//		non-inline:
+//			CNameTable();
+//			int find(const char* text, size_t len) const;
+//			int intern(const char* text, size_t len);
+//		private:
+//			static unsigned hash(const char* text, size_t len);
+//			void grow();
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	class CNameTable
+	{
+	public:
+		CNameTable();
+		int find(const char* text, size_t len) const;
+		int intern(const char* text, size_t len);
+		size_t size() const { return m_names.size(); }
+		const std::string& name(int slot) const { return m_names[slot]; }
+
+	private:
+		static unsigned hash(const char* text, size_t len);
+		void grow();
+
+		std::vector<int> m_index;
+		std::vector<unsigned> m_hashes;
+		std::vector<std::string> m_names;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,48 @@
+//----------------------------------------------------------------------------
+//    Class:		CPipeQueue
+//
+//    File:       CalcPipe.cpp
+//
+//    Description: This file contains the function definitions for
+//					CPipeQueue
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcPipe.h"
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CPipeQueue()
+	//	Description:	An empty queue.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CPipeQueue::CPipeQueue() : m_head(0), m_tail(0), m_taken(0),
+		m_waiting(0), m_peak(0)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			averageWaiting()
+	//	Description:	The average number of batches queued when the
+	//						consumer took one: near SLOTS, the consumer is
+	//						the slower side; near 1, the producer is.
+	//						Read it once both sides are done.
+	//	Programmers:	David Landry
+	//	Returns:		double -- the average (0 if none were taken)
+	//	Called by:		CRPNCalc::runPipeline()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	double CPipeQueue::averageWaiting() const
+	{
+		return m_taken ? static_cast<double>(m_waiting) / m_taken : 0.0;
+	}
+} // end namespace TPUS_CALC
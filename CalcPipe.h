@@ -0,0 +1,139 @@
+//----------------------------------------------------------------------------
+//    File:		CalcPipe.h
+//
+//    Class:	CPipeQueue
+//----------------------------------------------------------------------------
+#ifndef CALCPIPE_H
+#define CALCPIPE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "CalcShared.h"
+//----------------------------------------------------------------------------
+//
+//    Title:		CPipeQueue Class
+//
+//    Description:	The link between two stages of a pipeline: a bounded
+//						single-producer, single-consumer ring of SLOTS
+//						batches of up to PIPE_BATCH values each.  The
+//						producer fills the slot claim() gives it in
+//						place and publish()es it; the consumer reads
+//						the slot front() gives it in place and
+//						release()s it.  Only the producer writes m_head
+//						and only the consumer writes m_tail, each on its
+//						own cache line, so neither side ever takes a
+//						lock; a release store of one index after the
+//						slot is done and an acquire load of it on the
+//						other side is all the ordering needed.
+//						The consumer side also counts how many batches
+//						were waiting each time it took one, which shows
+//						whether the stage after the queue keeps up.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  struct PipeBatch -- one batch: values, their error flags, and whether
+//		it ends the stream
+//	  struct PipeStats -- one stage's counters
+//
+//	  class CPipeQueue:
+//
+//	  Properties:
+//		PipeBatch m_slots[SLOTS] -- the ring
+//		atomic<size_t> m_head -- batches published (producer)
+//		atomic<size_t> m_tail -- batches released (consumer)
+//		uint64_t m_taken -- batches front() has handed out
+//		uint64_t m_waiting -- the sum of the batches queued at each of them
+//		size_t m_peak -- the most batches ever queued
+//
+//	  Methods:
+//
+//		inline:
+//			PipeBatch* claim() -- the slot to fill, or null if full
+//			void publish()
+//			PipeBatch* front() -- the oldest batch, or null if empty
+//			void release()
+//			size_t peak() const
+//
+//		non-inline:
+//			CPipeQueue();
+//			double averageWaiting() const;
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	const size_t PIPE_BATCH = 256;		// values per batch
+
+	struct PipeBatch
+	{
+		size_t count;
+		bool last;						// no batches follow
+		double values[PIPE_BATCH];
+		bool errors[PIPE_BATCH];
+	};
+
+	struct PipeStats
+	{
+		uint64_t records;
+		uint64_t busyNanos;				// running the program
+		uint64_t inputNanos;			// waiting for a batch
+		uint64_t outputNanos;			// waiting for room downstream
+	};
+
+	class CPipeQueue
+	{
+	public:
+		static const size_t SLOTS = 16;		// a power of 2
+
+		CPipeQueue();
+		PipeBatch* claim()
+		{
+			size_t head = m_head.load(std::memory_order_relaxed);
+			if (head - m_tail.load(std::memory_order_acquire) == SLOTS)
+				return 0;
+			return &m_slots[head & (SLOTS - 1)];
+		}
+		void publish()
+		{
+			m_head.store(m_head.load(std::memory_order_relaxed) + 1,
+				std::memory_order_release);
+		}
+		PipeBatch* front()
+		{
+			size_t tail = m_tail.load(std::memory_order_relaxed);
+			size_t queued = m_head.load(std::memory_order_acquire) - tail;
+			if (queued == 0)
+				return 0;
+			m_taken++;
+			m_waiting += queued;
+			if (queued > m_peak)
+				m_peak = queued;
+			return &m_slots[tail & (SLOTS - 1)];
+		}
+		void release()
+		{
+			m_tail.store(m_tail.load(std::memory_order_relaxed) + 1,
+				std::memory_order_release);
+		}
+		double averageWaiting() const;
+		size_t peak() const { return m_peak; }
+
+	private:
+		CPipeQueue(const CPipeQueue&);					// not copyable
+		CPipeQueue& operator=(const CPipeQueue&);
+
+		PipeBatch m_slots[SLOTS];
+		alignas(CACHE_LINE) std::atomic<size_t> m_head;
+		alignas(CACHE_LINE) std::atomic<size_t> m_tail;
+		uint64_t m_taken;
+		uint64_t m_waiting;
+		size_t m_peak;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,306 @@
+#include "RPNCalc.h"
+#include <charconv>
+#include <chrono>
+#include <memory>
+namespace TPUS_CALC
+{
+	typedef std::chrono::steady_clock PipeClock;
+
+	static uint64_t nanosSince(PipeClock::time_point start)
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			PipeClock::now() - start).count();
+	}
+
+	// Spins until the queue has a batch to read, adding any wait to waited.
+	static PipeBatch* awaitFront(CPipeQueue& queue, uint64_t& waited)
+	{
+		PipeBatch* batch = queue.front();
+		if (batch)
+			return batch;
+		PipeClock::time_point start = PipeClock::now();
+		while (!(batch = queue.front()))
+			this_thread::yield();
+		waited += nanosSince(start);
+		return batch;
+	}
+
+	// Spins until the queue has a slot to fill, adding any wait to waited.
+	static PipeBatch* awaitClaim(CPipeQueue& queue, uint64_t& waited)
+	{
+		PipeBatch* batch = queue.claim();
+		if (batch)
+			return batch;
+		PipeClock::time_point start = PipeClock::now();
+		while (!(batch = queue.claim()))
+			this_thread::yield();
+		waited += nanosSince(start);
+		return batch;
+	}
+
+	// Reads the input's numbers, one record each, into batches on queue.
+	//	A token that is not a number goes in as an error record.
+	static void feedPipe(CBlockReader& reader, CPipeQueue& queue,
+		uint64_t& waited)
+	{
+		PipeBatch* batch = awaitClaim(queue, waited);
+		const char* line;
+		size_t len;
+
+		batch->count = 0;
+		while (reader.nextLine(line, len))
+		{
+			const char* end = line + len;
+			const char* scan = line;
+			while (true)
+			{
+				while (scan < end && isspace(static_cast<unsigned char>(*scan)))
+					scan++;
+				if (scan == end)
+					break;
+				const char* token = scan;
+				while (scan < end
+					&& !isspace(static_cast<unsigned char>(*scan)))
+					scan++;
+				double& value = batch->values[batch->count];
+				from_chars_result parsed = from_chars(token, scan, value);
+				batch->errors[batch->count] = (parsed.ec != errc()
+					|| parsed.ptr != scan);
+				if (++batch->count == PIPE_BATCH)
+				{
+					batch->last = false;
+					queue.publish();
+					batch = awaitClaim(queue, waited);
+					batch->count = 0;
+				}
+			}
+		}
+		batch->last = true;
+		queue.publish();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			runPipeline(int count, char* programs[],
+	//						CBlockReader& reader, ostream& ostr, ostream& log)
+	//	Description:	Runs each number in the input through a chain of
+	//						programs: the first program's result is the
+	//						second one's input, and so on, and the last
+	//						one's result is written to ostr, one per line
+	//						("<<error>>" for a record that failed at any
+	//						stage).  Each program is a stage with its own
+	//						calculator and thread; for each record it
+	//						starts from a stack holding just that number
+	//						and passes on the top of the stack.  Registers
+	//						are the stage's own and carry over from record
+	//						to record.  The reader, the stages and the
+	//						writer (this thread) are linked by CPipeQueues,
+	//						so every stage runs at once on different
+	//						batches.
+	//						When the input is done, each stage's counters
+	//						and each queue's occupancy go to log.  The
+	//						slowest stage is the one with the most busy
+	//						time; the queue in front of it stays nearly
+	//						full and the ones after it nearly empty.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		int count, char* programs[] -- the stages' program
+	//						files, in order
+	//					CBlockReader& reader -- the input
+	//					ostream& ostr -- where results go
+	//					ostream& log -- the counters and error messages
+	//	Returns:		bool -- false if a program could not be read or
+	//						cannot run as a stage
+	//	Called by:		runPipeMode()
+	//	Calls:			CProgram::read(); compileProgram(); stageBlocker();
+	//						feedPipe(); runStage(); CNumberFormat::write()
+	//	Input:			The program files and the records.
+	//	Output:			The results and the counters.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL rejecting stages stageBlocker() finds
+	//------------------------------------------------------------------------
+	bool CRPNCalc::runPipeline(int count, char* programs[],
+		CBlockReader& reader, ostream& ostr, ostream& log)
+	{
+		vector<unique_ptr<CRPNCalc> > stages;
+		vector<unique_ptr<CPipeQueue> > queues;
+		vector<PipeStats> stats(count);
+		vector<thread> threads;
+		CNumberFormat format;
+		uint64_t written = 0;
+		uint64_t feedWaited = 0;
+		uint64_t waited = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			stages.push_back(unique_ptr<CRPNCalc>(new CRPNCalc(false)));
+			if (!stages.back()->m_program.read(programs[i]))
+			{
+				log << "Cannot read " << programs[i] << endl;
+				return false;
+			}
+			stages.back()->compileProgram();
+			int line = stages.back()->stageBlocker();
+			if (line >= 0)
+			{
+				log << programs[i] << " line " << line + 1 << ": a pipeline"
+					" stage cannot prompt, exit or load from the library"
+					<< endl;
+				return false;
+			}
+			memset(&stats[i], 0, sizeof(stats[i]));
+		}
+		for (int i = 0; i <= count; i++)
+			queues.push_back(unique_ptr<CPipeQueue>(new CPipeQueue));
+
+		PipeClock::time_point start = PipeClock::now();
+		threads.push_back(thread(feedPipe, ref(reader), ref(*queues[0]),
+			ref(feedWaited)));
+		for (int i = 0; i < count; i++)
+			threads.push_back(thread(&CRPNCalc::runStage, stages[i].get(),
+				ref(*queues[i]), ref(*queues[i + 1]), ref(stats[i])));
+		CPipeQueue& results = *queues[count];
+		bool last = false;
+		while (!last)
+		{
+			PipeBatch* batch = awaitFront(results, waited);
+			for (size_t i = 0; i < batch->count; i++)
+			{
+				if (batch->errors[i])
+					ostr << "<<error>>";
+				else
+					format.write(ostr, batch->values[i]);
+				ostr << '\n';
+			}
+			written += batch->count;
+			last = batch->last;
+			results.release();
+		}
+		ostr.flush();
+		for (size_t i = 0; i < threads.size(); i++)
+			threads[i].join();
+		double seconds = nanosSince(start) / 1e9;
+
+		size_t slowest = 0;
+		log << written << " records in " << seconds << " s; the reader"
+			" waited " << feedWaited / 1e9 << " s for room, the writer "
+			<< waited / 1e9 << " s for results" << endl;
+		for (int i = 0; i < count; i++)
+		{
+			const PipeStats& stage = stats[i];
+			double busy = stage.busyNanos / 1e9;
+			log << "stage " << i + 1 << " (" << programs[i] << "): "
+				<< stage.records << " records, busy " << busy << " s ("
+				<< (busy > 0 ? stage.records / busy : 0.0)
+				<< " records/s), waited " << stage.inputNanos / 1e9
+				<< " s for input, " << stage.outputNanos / 1e9
+				<< " s for output" << endl;
+			if (stage.busyNanos > stats[slowest].busyNanos)
+				slowest = i;
+		}
+		for (int i = 0; i <= count; i++)
+		{
+			log << "queue " << i << " -> ";
+			if (i < count)
+				log << "stage " << i + 1;
+			else
+				log << "output";
+			log << ": " << queues[i]->averageWaiting() << " of "
+				<< CPipeQueue::SLOTS << " batches waiting on average, "
+				<< queues[i]->peak() << " at most" << endl;
+		}
+		if (count)
+			log << "slowest: stage " << slowest + 1 << endl;
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			runStage(CPipeQueue& input, CPipeQueue& output,
+	//						PipeStats& stats)
+	//	Description:	One stage of runPipeline(), on its own thread: takes
+	//						each batch from input, runs the program on each
+	//						of its records and puts the results on output,
+	//						until the last batch has gone through.  A record
+	//						that failed upstream passes through untouched.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		CPipeQueue& input -- batches from the stage before
+	//					CPipeQueue& output -- batches for the stage after
+	//					PipeStats& stats -- this stage's counters
+	//	Returns:		None
+	//	Called by:		runPipeline()
+	//	Calls:			runProgram()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::runStage(CPipeQueue& input, CPipeQueue& output,
+		PipeStats& stats)
+	{
+		bool last = false;
+		while (!last)
+		{
+			PipeBatch* in = awaitFront(input, stats.inputNanos);
+			PipeBatch* out = awaitClaim(output, stats.outputNanos);
+			PipeClock::time_point start = PipeClock::now();
+			for (size_t i = 0; i < in->count; i++)
+			{
+				bool failed = in->errors[i];
+				double value = in->values[i];
+				if (!failed)
+				{
+					m_stack.clear();
+					stackTouched(0);
+					m_stack.push_front(value);
+					runProgram();
+					failed = m_error || m_stack.empty()
+						|| isBoxed(m_stack.front());
+					value = failed ? NAN : m_stack.front();
+					m_error = false;
+				}
+				out->values[i] = value;
+				out->errors[i] = failed;
+			}
+			out->count = in->count;
+			out->last = last = in->last;
+			stats.records += in->count;
+			stats.busyNanos += nanosSince(start);
+			output.publish();
+			input.release();
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			stageBlocker()
+	//	Description:	Finds the first command in the compiled program that
+	//						a pipeline stage cannot run: one that prompts
+	//						(its thread has no console), EXIT, or LOADN
+	//						(a stage has no library open).
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		int -- that command's source line, or -1 if there
+	//						is none
+	//	Called by:		runPipeline()
+	//	Calls:			promptsUser()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	int CRPNCalc::stageBlocker() const
+	{
+		const vector<Instr>& code = m_program.code();
+		for (size_t i = 0; i < code.size() && code[i].op != STOP; i++)
+		{
+			cmd op = static_cast<cmd>(code[i].op);
+			if (promptsUser(op) || op == EXIT || op == LOADN)
+				return code[i].line;
+		}
+		return -1;
+	}
+} // end namespace TPUS_CALC
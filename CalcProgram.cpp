@@ -0,0 +1,180 @@
+//----------------------------------------------------------------------------
+//    Class:		CProgram
+//
+//    File:       CalcProgram.cpp
+//
+//    Description: This file contains the function definitions for CProgram
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcProgram.h"
+#include <fstream>
+#include <utility>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CProgram()
+	//	Description:	Creates an empty program.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CProgram::CProgram() : m_compiled(false), m_signed(false)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			clear()
+	//	Description:	Empties the program and gives its arenas back; each
+	//						arena is a single block, so this is one free
+	//						apiece rather than one per line.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CProgram::clear()
+	{
+		vector<char>().swap(m_text);
+		vector<unsigned>().swap(m_offsets);
+		vector<Instr>().swap(m_code);
+		m_compiled = false;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			append(const char* text, size_t len)
+	//	Description:	Adds one line to the end of the program.  A '\n' is
+	//						added if the line does not already end in one.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* text -- the line
+	//					size_t len -- its length
+	//	Called by:		CRPNCalc::recordProgram()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CProgram::append(const char* text, size_t len)
+	{
+		m_offsets.push_back(static_cast<unsigned>(m_text.size()));
+		m_text.insert(m_text.end(), text, text + len);
+		if (len == 0 || text[len - 1] != '\n')
+			m_text.push_back('\n');
+		m_compiled = false;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			assign(const char* text, size_t len)
+	//	Description:	Replaces the program with the given text (for example,
+	//						a whole .clc file), indexing it line by line.  A
+	//						last line without a '\n' gets one.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* text -- the program text
+	//					size_t len -- its length
+	//	Called by:		CRPNCalc::loadProgram()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CProgram::assign(const char* text, size_t len)
+	{
+		clear();
+		m_text.reserve(len + 1);
+		m_text.assign(text, text + len);
+		if (len > 0 && text[len - 1] != '\n')
+			m_text.push_back('\n');
+		for (size_t i = 0; i < m_text.size(); i++)
+		{
+			if (i == 0 || m_text[i - 1] == '\n')
+				m_offsets.push_back(static_cast<unsigned>(i));
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			read(const char* fileName)
+	//	Description:	Replaces the program with a .clc file, read in one
+	//						block.  Text mode may translate line endings,
+	//						so the size read comes from gcount(), not the
+	//						file.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* fileName -- the file
+	//	Returns:		bool -- false (and the program unchanged) if the
+	//						file cannot be opened
+	//	Called by:		CRPNCalc::loadProgram(); CRPNCalc::reloadProgram();
+	//						CRPNCalc::packLibrary()
+	//	Changelog:		10/19/2026	DL completed version 1.0 (was
+	//									readProgramFile() in
+	//									CalcProgramMacroMethods.cpp)
+	//------------------------------------------------------------------------
+	bool CProgram::read(const char* fileName)
+	{
+		ifstream fileStream(fileName);
+		streamoff length;
+		vector<char> text;
+
+		if (!fileStream)
+			return false;
+		fileStream.seekg(0, ios::end);
+		length = fileStream.tellg();
+		fileStream.seekg(0, ios::beg);
+		text.resize(length > 0 ? static_cast<size_t>(length) : 0);
+		if (!text.empty())
+			fileStream.read(&text[0], length);
+		text.resize(static_cast<size_t>(fileStream.gcount()));
+		assign(text.empty() ? "" : &text[0], text.size());
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			list(ostream& ostr)
+	//	Description:	Prints the lines of the program with their indexes,
+	//						followed by the program's size in memory.
+	//	Programmers:	David Landry
+	//	Parameters:		ostream& ostr -- where the listing goes
+	//	Called by:		CRPNCalc::recordProgram(); CRPNCalc::loadProgram()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CProgram::list(ostream& ostr) const
+	{
+		ostr << "Index:\tCommand:\n";
+		for (size_t i = 0; i < size(); i++)
+		{
+			ostr << "  " << i << "\t";
+			ostr.write(line(i), lineLength(i));
+		}
+		ostr << "(" << size() << " lines, " << bytes() << " bytes)\n";
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			bytes()
+	//	Description:	Heap memory held by the program: text arena, line
+	//						index and compiled code.
+	//	Programmers:	David Landry
+	//	Returns:		the footprint in bytes
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	size_t CProgram::bytes() const
+	{
+		return m_text.capacity() + m_offsets.capacity() * sizeof(unsigned)
+			+ m_code.capacity() * sizeof(Instr);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			swap(CProgram& other)
+	//	Description:	Exchanges two programs, text and code, without
+	//						copying either.
+	//	Programmers:	David Landry
+	//	Parameters:		CProgram& other -- the other program
+	//	Called by:		CRPNCalc::reloadProgram()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CProgram::swap(CProgram& other)
+	{
+		m_text.swap(other.m_text);
+		m_offsets.swap(other.m_offsets);
+		m_code.swap(other.m_code);
+		std::swap(m_compiled, other.m_compiled);
+		std::swap(m_signature, other.m_signature);
+		std::swap(m_signed, other.m_signed);
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,149 @@
+//----------------------------------------------------------------------------
+//    File:		CalcProgram.h
+//
+//    Class:	CProgram
+//----------------------------------------------------------------------------
+#ifndef CALCPROGRAM_H
+#define CALCPROGRAM_H
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		CProgram Class
+//
+//    Description:	Storage for the calculator program.  All of the program
+//						text lives in one contiguous arena with an offsets
+//						index (one entry per line), and the compiled form
+//						lives in a second arena of fixed-size instructions.
+//						Recording or loading a line appends to the arena
+//						instead of allocating a list node and a string.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  struct Instr:
+//		int op -- cmd enum value (PUSH for numbers and constants)
+//		int line -- index of the source line
+//		double value -- the number pushed by PUSH
+//		int slot -- named register used by GETN/SETN (shares value's space)
+//
+//	  struct StackSignature:
+//		bool verified -- every instruction has a fixed stack effect
+//		size_t inputs -- stack entries the program needs on entry (and
+//			the most it ever takes below the entry depth)
+//		size_t outputs -- entries it leaves in their place
+//		size_t maxGrowth -- most entries above the entry depth at any point
+//		bool rotates -- D or U: touches the bottom of the stack
+//		unsigned registersRead -- bit r: G r reads register r
+//		bool readsNamed -- G:name reads a named register
+//
+//	  class CProgram:
+//
+//	  Properties:
+//		vector<char> m_text -- every line, each ending in '\n'
+//		vector<unsigned> m_offsets -- start of each line in m_text
+//		vector<Instr> m_code -- compiled instructions
+//		bool m_compiled -- m_code matches m_text
+//		StackSignature m_signature -- the verifier's findings on m_code
+//		bool m_signed -- m_signature is up to date
+//
+//	  Methods:
+//
+//		inline:
+//			size_t size() const
+//			bool empty() const
+//			const char* line(size_t i) const
+//			size_t lineLength(size_t i) const
+//			const char* text() const
+//			size_t textSize() const
+//			bool compiled() const
+//			vector<Instr>& code() / const vector<Instr>& code() const
+//			void setCompiled()
+//			const StackSignature* signature() const
+//			void setSignature(const StackSignature& signature)
+//
+//		non-inline:
+//			CProgram();
+//			void clear();
+//			void append(const char* text, size_t len);
+//			void assign(const char* text, size_t len);
+//			bool read(const char* fileName);
+//			void list(ostream& ostr) const;
+//			size_t bytes() const;
+//			void swap(CProgram& other);
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	struct Instr
+	{
+		int op;
+		int line;
+		union
+		{
+			double value;
+			int slot;
+		};
+	};
+
+	struct StackSignature
+	{
+		bool verified;
+		size_t inputs;
+		size_t outputs;
+		size_t maxGrowth;
+		bool rotates;
+		unsigned registersRead;
+		bool readsNamed;
+	};
+
+	class CProgram
+	{
+	public:
+		CProgram();
+		void clear();
+		void append(const char* text, size_t len);
+		void assign(const char* text, size_t len);
+		bool read(const char* fileName);
+		void list(std::ostream& ostr) const;
+		size_t bytes() const;
+		void swap(CProgram& other);
+
+		size_t size() const { return m_offsets.size(); }
+		bool empty() const { return m_offsets.empty(); }
+		const char* line(size_t i) const { return &m_text[m_offsets[i]]; }
+		size_t lineLength(size_t i) const
+		{
+			return ((i + 1 < m_offsets.size()) ? m_offsets[i + 1]
+				: m_text.size()) - m_offsets[i];
+		}
+		const char* text() const
+			{ return m_text.empty() ? "" : &m_text[0]; }
+		size_t textSize() const { return m_text.size(); }
+		bool compiled() const { return m_compiled; }
+		std::vector<Instr>& code() { return m_code; }
+		const std::vector<Instr>& code() const { return m_code; }
+		void setCompiled() { m_compiled = true; m_signed = false; }
+		// The signature of the compiled code, once it has been verified.
+		const StackSignature* signature() const
+			{ return (m_compiled && m_signed) ? &m_signature : 0; }
+		void setSignature(const StackSignature& signature)
+			{ m_signature = signature; m_signed = true; }
+
+	private:
+		std::vector<char> m_text;
+		std::vector<unsigned> m_offsets;
+		std::vector<Instr> m_code;
+		bool m_compiled;
+		StackSignature m_signature;
+		bool m_signed;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -1,6 +1,14 @@
 #include "RPNCalc.h"
 namespace TPUS_CALC
 {
+	// Tells whether line i of one program and line j of another match.
+	static bool sameLine(const CProgram& a, size_t i, const CProgram& b,
+		size_t j)
+	{
+		return a.lineLength(i) == b.lineLength(j)
+			&& memcmp(a.line(i), b.line(j), a.lineLength(i)) == 0;
+	}
+
 	//------------------------------------------------------------------------
 	//	Method:			recordProgram()
 	//	Description:	Takes command-line input and loads it into m_program.
@@ -24,12 +32,13 @@ namespace TPUS_CALC
 	//					6/11/2016	DL completed version 0.9, adding this
 	//									method header.
 	//					6/12/2016	DL completed version 1.0.
+	//					10/19/2026	DL completed version 1.1, appending to
+	//									the CProgram arena.
 	//------------------------------------------------------------------------
 	void CRPNCalc::recordProgram()
 	{
 		char choice = ' ';
 		bool isEmpty = false;
-		list<string>::iterator scanProgram = m_program.begin();
 		// Selecting N will clear out m_program before recording a new
 		//	program.  Selecting C will keep m_program as is, allowing the user
 		//	to insert new lines starting at the end of the program.
@@ -43,6 +52,7 @@ namespace TPUS_CALC
 			m_error = true;
 		if (!m_error)
 		{
+			m_profile.clear();	// line costs no longer match the program
 			cout << "Enter P at any line to view program and exit programming"
 				" mode.\n";
 			// This program uses m_buffer, so clear out any leftover junk.
@@ -63,13 +73,7 @@ namespace TPUS_CALC
 				{
 					if (m_program.size() > 0)
 					{
-						cout << "Index:\tCommand:\n";
-						unsigned short i = 0;
-						for (scanProgram = m_program.begin();
-							scanProgram != m_program.end(); scanProgram++)
-						{
-							cout << "  " << i++ << "\t" << *scanProgram;
-						}
+						m_program.list(cout);
 						cout << "Press \"Enter\" to return to the calculator.";
 						cin.get();
 					}
@@ -79,7 +83,7 @@ namespace TPUS_CALC
 				else
 					// As long as any text besides P is entered, the entered
 					//	line of programming gets pushed into m_program.
-					m_program.push_back(m_buffer);
+					m_program.append(m_buffer.c_str(), m_buffer.size());
 			}
 		}
 	}
@@ -87,13 +91,16 @@ namespace TPUS_CALC
 	//------------------------------------------------------------------------
 	//	Method:			runProgram()
 	//	Description:	Runs the program in m_program.
-	//	Date:			6/12/2016
-	//	Version:		1.0
+	//	Date:			10/19/2026
+	//	Version:		1.6
 	//	Programmers:	DL
 	//	Parameters:		None
 	//	Returns:		None
 	//	Called by:		cmd_parse()
-	//	Calls:			parse()
+	//	Calls:			programSignature(); canRunVerified(); runVerified();
+	//						compileProgram(); execute(); runInstrumented();
+	//						snapshot(); restore(); CRunLimits::start();
+	//						CRunLimits::exceeded(); CRunLimits::finish()
 	//	Input:			None
 	//	Output:			None
 	//	Throws:			None
@@ -106,25 +113,66 @@ namespace TPUS_CALC
 	//									issue with setting the m_error flag
 	//									in the middle of a running program.
 	//					6/12/2016	DL completed version 1.0.
+	//					10/19/2026	DL completed version 1.1, recording each
+	//									line in m_trace when tracing is on.
+	//					10/19/2026	DL completed version 1.2, moving tracing
+	//									into runInstrumented() and adding
+	//									profiling.
+	//					10/19/2026	DL completed version 1.3, running the
+	//									compiled instructions instead of
+	//									re-parsing every line.
+	//					10/19/2026	DL completed version 1.4, continuing
+	//									into a program loaded with L:name.
+	//					10/19/2026	DL completed version 1.5, running a
+	//									verified program with runVerified().
+	//					10/19/2026	DL completed version 1.6, enforcing
+	//									m_limits: a run stopped by a limit
+	//									is undone.
 	//------------------------------------------------------------------------
 	void CRPNCalc::runProgram()
 	{
 		bool tempError = false;
-		list<string>::iterator programScanner = m_program.begin();
-		// Run each list element through parse.  Each element should represent
-		//	one line of recorded programming.  Error lines will be processed,
-		//	but will set the error flag, displaying error at the next print
-		//	method call.  However, each line of the program will be run
-		//	regardless.
-		for (; programScanner != m_program.end(); programScanner++)
+		// A program run from a program shares the outer run's limits.
+		bool limited = m_limits.active() && !m_limits.running();
+		CSnapshot before;
+		if (limited)
 		{
-			m_instrStream.str(*programScanner);
-			m_buffer = m_instrStream.str();
-			if (toupper(m_buffer[0]) == 'P')
-				programScanner = --m_program.end();
-			else
+			before = snapshot();
+			m_limits.start();
+		}
+		// A program with a fixed stack effect has its depth checked once
+		//	here and then runs without checks on each line, unless it is
+		//	being traced or profiled.
+		const StackSignature& signature = programSignature();
+		if (!m_trace.enabled() && !m_profileOn && canRunVerified(signature))
+			tempError = runVerified(signature);
+		else
+		{
+			// Run each compiled instruction.  Each one represents one line
+			//	of recorded programming.  Error lines will be processed, but
+			//	will set the error flag, displaying error at the next print
+			//	method call.  However, each line of the program will be run
+			//	regardless, unless a limit stops the run.  The code is
+			//	indexed rather than iterated because a line may load a new
+			//	program while this one runs.  A program loaded with L:name
+			//	takes over the run from its first line.
+			for (size_t i = 0; i < m_program.code().size(); i++)
 			{
-				parse();
+				const Instr& instr = m_program.code()[i];
+				bool chained = (instr.op == LOADN);
+				if (instr.op == STOP || m_limits.exceeded(m_stack.size()))
+					break;
+				if (m_trace.enabled() || m_profileOn)
+					runInstrumented(instr);
+				else
+					execute(instr);
+				if (chained && !m_error)
+				{
+					if (!m_program.compiled())
+						compileProgram();
+					i = static_cast<size_t>(-1);
+					continue;
+				}
 				// Temporarily clear out any errors so that the program may
 				//	run in its entirety.  Reset the error flag after the
 				//	program runs if there was one in the program.
@@ -134,10 +182,153 @@ namespace TPUS_CALC
 					m_error = false;
 				}
 			}
-			m_instrStream.clear();
 		}
 		if (tempError)
 			m_error = true;
+		if (limited && m_limits.finish(m_stack.size()))
+		{
+			restore(before);
+			m_error = true;
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			compileProgram()
+	//	Description:	Compiles every line of m_program into its instruction
+	//						arena.  A line starting with P ends the program.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		runProgram()
+	//	Calls:			compileLine()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::compileProgram()
+	{
+		vector<Instr>& code = m_program.code();
+		code.clear();
+		code.reserve(m_program.size());
+		for (size_t i = 0; i < m_program.size(); i++)
+		{
+			const char* text = m_program.line(i);
+			if (toupper(text[0]) == 'P')
+			{
+				Instr stop = { STOP, static_cast<int>(i), 0.0 };
+				code.push_back(stop);
+				break;
+			}
+			code.push_back(compileLine(text, m_program.lineLength(i),
+				static_cast<int>(i)));
+		}
+		m_program.setCompiled();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			runInstrumented(const Instr& instr)
+	//	Description:	Executes one program instruction and records it in
+	//						the tracer and/or the profiler, whichever is on.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		const Instr& instr -- the instruction to run
+	//	Returns:		None
+	//	Called by:		runProgram()
+	//	Calls:			execute(); cycleCount(); CTraceBuffer::record()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, running a
+	//									compiled instruction.
+	//					10/19/2026	DL completed version 1.2, not touching
+	//									instr or the profile after a line
+	//									that loads a new program.
+	//------------------------------------------------------------------------
+	void CRPNCalc::runInstrumented(const Instr& instr)
+	{
+		TraceEvent event;
+		bool tracing = m_trace.enabled();
+		int lineIndex = instr.line;
+		int op = instr.op;			// instr goes away if op loads a program
+		if (tracing)
+			event.ts = CTraceBuffer::now();
+		unsigned long long startCycles = cycleCount();
+		execute(instr);
+		unsigned long long cycles = cycleCount() - startCycles;
+		if (m_profileOn && op != LOAD && op != LOADN)
+		{
+			if (m_profile.size() < m_program.size())
+				m_profile.resize(m_program.size(), ProfileEntry());
+			m_profile[lineIndex].count++;
+			m_profile[lineIndex].cycles += cycles;
+		}
+		if (tracing)
+		{
+			event.dur = CTraceBuffer::now() - event.ts;
+			event.line = lineIndex;
+			event.op = op;
+			event.depth = static_cast<unsigned>(m_stack.size());
+			event.top = m_stack.empty() ? 0.0 : m_stack.front();
+			m_trace.record(event);
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			printProfile()
+	//	Description:	Prints the program listing annotated with how often
+	//						each line ran and the cycles it used.  The three
+	//						costliest lines are marked with a *.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			None
+	//	Input:			"Enter" to return to the calculator.
+	//	Output:			The annotated program listing.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, counting lines
+	//									with a size_t, which cannot wrap.
+	//------------------------------------------------------------------------
+	void CRPNCalc::printProfile()
+	{
+		const unsigned HOT_LINES = 3;
+		unsigned long long total = 0;
+		vector<unsigned long long> ranked;
+		unsigned long long hotLimit = 0;
+		size_t i = 0;
+
+		if (m_profile.size() < m_program.size())
+			m_profile.resize(m_program.size(), ProfileEntry());
+		for (i = 0; i < m_program.size(); i++)
+		{
+			total += m_profile[i].cycles;
+			ranked.push_back(m_profile[i].cycles);
+		}
+		// Anything at or above the HOT_LINES-th largest cost gets a *.
+		sort(ranked.begin(), ranked.end(), greater<unsigned long long>());
+		if (!ranked.empty())
+			hotLimit = ranked[min<size_t>(HOT_LINES, ranked.size()) - 1];
+
+		cout << "Index:\tCount:\tCycles:\t%:\tCommand:\n";
+		for (i = 0; i < m_program.size(); i++)
+		{
+			const ProfileEntry& entry = m_profile[i];
+			bool hot = entry.cycles > 0 && entry.cycles >= hotLimit;
+			cout << (hot ? "* " : "  ") << i << "\t" << entry.count << "\t"
+				<< entry.cycles << "\t"
+				<< (total ? (100.0 * entry.cycles / total) : 0.0) << "\t";
+			cout.write(m_program.line(i), m_program.lineLength(i));
+		}
+		cout << "Press \"Enter\" to return to the calculator.";
+		cin.get();
 	}
 
 	//------------------------------------------------------------------------
@@ -161,12 +352,13 @@ namespace TPUS_CALC
 	//					6/11/2016	DL completed version 0.9, adding this
 	//									method header.
 	//					6/12/2016	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, writing the
+	//									program arena in one block.
 	//------------------------------------------------------------------------
 	void CRPNCalc::saveToFile()
 	{
 		ofstream fileStream;
 		char fileName[BUFFER_SIZE];
-		list<string>::iterator programScanner;
 		cout << "Please enter a file name to save your program to." << endl;
 		cout << "(The file will be automatically saved as a .clc file.)  ";
 		(cin >> fileName).get();
@@ -182,9 +374,7 @@ namespace TPUS_CALC
 			}
 			else
 			{
-				for (programScanner = m_program.begin();
-					programScanner != m_program.end(); programScanner++)
-					fileStream << *programScanner;
+				fileStream.write(m_program.text(), m_program.textSize());
 				fileStream.close();
 				cout << "Done.  Press \"Enter\" to continue.";
 			}
@@ -198,6 +388,51 @@ namespace TPUS_CALC
 		cin.get();
 	}
 
+	//------------------------------------------------------------------------
+	//	Method:			exportTrace()
+	//	Description:	Asks the user for a filename and writes the execution
+	//						trace to it as Chrome trace_event JSON
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			CTraceBuffer::exportChrome()
+	//	Input:			The file name.
+	//	Output:			Prompts for the file name and error messages, if
+	//						applicable.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::exportTrace()
+	{
+		ofstream fileStream;
+		char fileName[BUFFER_SIZE];
+		vector<string> opNames(NUMCMDS);
+		RPNmap::iterator it;
+		for (it = m_map.begin(); it != m_map.end(); it++)
+			opNames[it->second] = it->first;
+		opNames[PUSH] = "push";
+		opNames[GETN] = "G:";
+		opNames[SETN] = "S:";
+		opNames[NOVAL] = "error";
+		cout << "Please enter a file name to save the trace to." << endl;
+		cout << "(The file will be automatically saved as a .json file.)  ";
+		(cin >> fileName).get();
+		strcat(fileName, ".json");
+		fileStream.open(fileName);
+		if (!fileStream)
+			cout << "Could not open the file.  Press \"Enter\" to continue.";
+		else
+		{
+			m_trace.exportChrome(fileStream, opNames);
+			fileStream.close();
+			cout << "Done.  Press \"Enter\" to continue.";
+		}
+		cin.get();
+	}
+
 	//------------------------------------------------------------------------
 	//	Method:			loadProgram()
 	//	Description:	Retrieves the filename from the user and loads it into
@@ -226,57 +461,172 @@ namespace TPUS_CALC
 	//					6/11/2016	DL completed version 0.9, adding this
 	//									method header.
 	//					6/12/2016	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, reading the
+	//									whole file in one block into the
+	//									CProgram arena instead of one
+	//									character at a time.
+	//					10/19/2026	DL completed version 1.2, remembering
+	//									the file for W and moving the watch
+	//									to it.
 	//------------------------------------------------------------------------
 	void CRPNCalc::loadProgram()
 	{
-		ifstream fileStream;
 		char fileName[BUFFER_SIZE];
-		list<string>::iterator scanProgram;
-		char testChar;
-		string individualCommand;
 		cout << "Please enter a file name to load your program from." << endl;
 		cout << "(The .clc extention will automatically be appended)  ";
 		(cin >> fileName).get();
 		strcat(fileName, ".clc");
 		try
 		{
-			fileStream.open(fileName);
-			if (!fileStream)
-			{
+			if (!m_program.read(fileName))
 				cout << "Could not find the indicated file."
 					"  Press \"Enter\" to continue.";
-				fileStream.clear();
-			}
 			else
 			{
-				m_program.clear();
-				while (fileStream.peek() != EOF)
-				{
-					individualCommand += fileStream.get();
-					if (fileStream.peek() == '\n')
-					{
-						individualCommand += fileStream.get();
-						m_program.push_back(individualCommand);
-						individualCommand.clear();
-					}
-				}
-				cout << "Index:\tCommand:\n";
-				unsigned short i = 0;
-				for (scanProgram = m_program.begin();
-					scanProgram != m_program.end(); scanProgram++)
-				{
-					cout << "  " << i++ << "\t" << *scanProgram;
-				}
+				m_profile.clear();
+				m_programFile = fileName;
+				if (m_watcher.isWatching())
+					m_watcher.watch(m_programFile);
+				m_program.list(cout);
 				cout << "Press \"Enter\" to continue.";
 			}
-			fileStream.close();
 			cin.get();
 		}
 		catch (exception e)
 		{
 			cout << "Could not open the file.  Press \"Enter\" to continue.";
-			fileStream.clear();
 		}
 	}
+
+	//------------------------------------------------------------------------
+	//	Method:			watchProgram()
+	//	Description:	W: starts or stops watching the file the program was
+	//						loaded from.  While watching, the program is
+	//						reloaded whenever the file is saved.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			CFileWatcher::watch(); CFileWatcher::stop()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::watchProgram()
+	{
+		if (m_watcher.isWatching())
+			m_watcher.stop();
+		else if (m_programFile.empty() || !m_watcher.watch(m_programFile))
+			m_error = true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			reloadIfChanged()
+	//	Description:	Reloads the program if its watched file was saved
+	//						since the last check.  It is called before each
+	//						input line, never while a line (and so a run)
+	//						is executing, so a run always sees one whole
+	//						program.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		input(); runBatch()
+	//	Calls:			CFileWatcher::changed(); reloadProgram();
+	//						compactJournal()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL compacting the journal, which cannot
+	//									replay a reload
+	//------------------------------------------------------------------------
+	void CRPNCalc::reloadIfChanged()
+	{
+		if (m_watcher.changed())
+		{
+			reloadProgram();
+			if (m_journal.isOpen())
+				compactJournal();
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			reloadProgram()
+	//	Description:	Reads the program file again and compiles the new
+	//						text into a separate CProgram, reusing the
+	//						compiled instruction of every line in the
+	//						unchanged head and tail of the file; only the
+	//						lines in between go through compileLine().
+	//						The finished program is then swapped in whole.
+	//						If the file cannot be read the old program
+	//						stays.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		reloadIfChanged()
+	//	Calls:			CProgram::read(); sameLine(); compileProgram();
+	//						compileLine(); CProgram::swap()
+	//	Input:			The program file.
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::reloadProgram()
+	{
+		CProgram fresh;
+		size_t oldLines = m_program.size();
+		size_t newLines;
+		size_t head = 0;
+		size_t tail = 0;
+
+		if (!fresh.read(m_programFile.c_str()))
+			return;
+		newLines = fresh.size();
+		if (!m_program.compiled())
+			compileProgram();
+		while (head < oldLines && head < newLines
+			&& sameLine(m_program, head, fresh, head))
+			head++;
+		while (tail < oldLines - head && tail < newLines - head
+			&& sameLine(m_program, oldLines - 1 - tail,
+				fresh, newLines - 1 - tail))
+			tail++;
+
+		// Code index i compiles line i (up to a P line), so an unchanged
+		//	line's instruction is found at its old line index.
+		const vector<Instr>& oldCode = m_program.code();
+		vector<Instr>& code = fresh.code();
+		code.reserve(newLines);
+		for (size_t i = 0; i < newLines; i++)
+		{
+			const char* text = fresh.line(i);
+			size_t old = (i < head) ? i
+				: (i >= newLines - tail) ? i - newLines + oldLines : oldLines;
+			if (toupper(text[0]) == 'P')
+			{
+				Instr stop = { STOP, static_cast<int>(i), 0.0 };
+				code.push_back(stop);
+				break;
+			}
+			if (old < oldCode.size())
+			{
+				code.push_back(oldCode[old]);
+				code.back().line = static_cast<int>(i);
+			}
+			else
+				code.push_back(compileLine(text, fresh.lineLength(i),
+					static_cast<int>(i)));
+		}
+		fresh.setCompiled();
+		m_program.swap(fresh);
+		m_profile.clear();
+	}
 }
 
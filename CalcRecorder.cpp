@@ -0,0 +1,155 @@
+//----------------------------------------------------------------------------
+//    Classes:		CRecordBuf, CReplayBuf
+//
+//    File:       CalcRecorder.cpp
+//
+//    Description: This file contains the function definitions for
+//					CRecordBuf and CReplayBuf
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcRecorder.h"
+#include <cstdlib>
+#include <thread>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	const char TRACE_HEADER[] = "RPNTRACE 1";
+
+	//------------------------------------------------------------------------
+	//	Method:			CRecordBuf(streambuf* source, const char* traceName)
+	//	Description:	Starts a trace file; recording times count from now.
+	//	Programmers:	David Landry
+	//	Parameters:		streambuf* source -- the keyboard's buffer
+	//					const char* traceName -- the trace file
+	//	Called by:		runRecordMode()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CRecordBuf::CRecordBuf(streambuf* source, const char* traceName)
+		: m_source(source), m_trace(traceName, ios::trunc),
+		m_start(chrono::steady_clock::now())
+	{
+		if (m_trace)
+			m_trace << TRACE_HEADER << '\n' << flush;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			underflow()
+	//	Description:	Reads the next line from the source, records it with
+	//						the time it arrived and hands it on.  Each line
+	//						is flushed to the trace at once, so a session
+	//						that is killed still leaves its trace.
+	//	Programmers:	David Landry
+	//	Returns:		int_type -- the line's first character, or eof
+	//	Called by:		the istream reading from this buffer
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CRecordBuf::int_type CRecordBuf::underflow()
+	{
+		m_line.clear();
+		int_type c;
+		while ((c = m_source->sbumpc()) != traits_type::eof())
+		{
+			m_line += traits_type::to_char_type(c);
+			if (c == '\n')
+				break;
+		}
+		if (m_line.empty())
+			return traits_type::eof();
+		uint64_t micros = chrono::duration_cast<chrono::microseconds>(
+			chrono::steady_clock::now() - m_start).count();
+		m_trace << micros << '\t' << m_line;
+		if (m_line[m_line.size() - 1] != '\n')
+			m_trace << '\n';
+		m_trace.flush();
+		char* begin = &m_line[0];
+		setg(begin, begin, begin + m_line.size());
+		return traits_type::to_int_type(*begin);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			CReplayBuf(const vector<TraceLine>& lines,
+	//						bool paced)
+	//	Description:	Serves lines, which must outlive the buffer; paced
+	//						times count from now.
+	//	Programmers:	David Landry
+	//	Parameters:		const vector<TraceLine>& lines -- the trace
+	//					bool paced -- keep to the recorded times
+	//	Called by:		CRPNCalc::replaySession()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CReplayBuf::CReplayBuf(const vector<TraceLine>& lines, bool paced)
+		: m_lines(lines), m_next(0), m_paced(paced),
+		m_start(chrono::steady_clock::now()), m_waitNanos(0)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			underflow()
+	//	Description:	Serves the next line, first waiting for its recorded
+	//						time if paced.
+	//	Programmers:	David Landry
+	//	Returns:		int_type -- the line's first character, or eof
+	//	Called by:		the istream reading from this buffer
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CReplayBuf::int_type CReplayBuf::underflow()
+	{
+		if (m_next == m_lines.size())
+			return traits_type::eof();
+		const TraceLine& next = m_lines[m_next++];
+		if (m_paced)
+		{
+			chrono::steady_clock::time_point due =
+				m_start + chrono::microseconds(next.micros);
+			chrono::steady_clock::time_point now = chrono::steady_clock::now();
+			if (due > now)
+			{
+				this_thread::sleep_until(due);
+				m_waitNanos += chrono::duration_cast<chrono::nanoseconds>(
+					chrono::steady_clock::now() - now).count();
+			}
+		}
+		m_line = next.text + '\n';
+		char* begin = &m_line[0];
+		setg(begin, begin, begin + m_line.size());
+		return traits_type::to_int_type(*begin);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			read(const char* traceName, vector<TraceLine>& lines)
+	//	Description:	Loads a trace written by CRecordBuf.
+	//	Programmers:	David Landry
+	//	Parameters:		const char* traceName -- the trace file
+	//					vector<TraceLine>& lines -- receives its records
+	//	Returns:		bool -- false if it is missing or not a trace
+	//	Called by:		runReplayMode()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CReplayBuf::read(const char* traceName, vector<TraceLine>& lines)
+	{
+		ifstream trace(traceName);
+		string text;
+		lines.clear();
+		if (!getline(trace, text) || text != TRACE_HEADER)
+			return false;
+		while (getline(trace, text))
+		{
+			size_t tab = text.find('\t');
+			if (tab == string::npos || tab == 0)
+				return false;
+			TraceLine line;
+			line.micros = strtoull(text.c_str(), 0, 10);
+			line.text = text.substr(tab + 1);
+			lines.push_back(line);
+		}
+		return true;
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,137 @@
+//----------------------------------------------------------------------------
+//    File:		CalcRecorder.h
+//
+//    Classes:	CRecordBuf, CReplayBuf, CNullBuf
+//----------------------------------------------------------------------------
+#ifndef CALCRECORDER_H
+#define CALCRECORDER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		Session Recorder Classes
+//
+//    Description:	Stream buffers for recording what a user types and
+//						playing it back.  A session trace is a text file:
+//							RPNTRACE 1
+//							<microseconds since the start> TAB <line>
+//							...
+//						with one record per line read from the keyboard,
+//						whether a command or the answer to a prompt (a
+//						file name, "Enter" to continue).
+//
+//						CRecordBuf sits in front of cin's own buffer and
+//						hands each line on unchanged, writing it to the
+//						trace with the time it arrived.
+//						CReplayBuf serves a trace's lines in place of the
+//						keyboard, at once or, paced, each no sooner than
+//						its recorded time; it counts the time it spent
+//						waiting so that can be left out of latencies.
+//						CNullBuf swallows output, so a replay still does
+//						all of its formatting but draws nothing.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  struct TraceLine -- one record: its time and text
+//
+//	  class CRecordBuf:
+//
+//	  Properties:
+//		streambuf* m_source -- where the lines really come from
+//		ofstream m_trace -- the trace file
+//		steady_clock::time_point m_start -- when recording began
+//		string m_line -- the line being handed on
+//
+//	  Methods:
+//		CRecordBuf(std::streambuf* source, const char* traceName);
+//		bool isOpen() const
+//		protected: int_type underflow();
+//
+//	  class CReplayBuf:
+//
+//	  Properties:
+//		const vector<TraceLine>& m_lines -- the trace
+//		size_t m_next -- the next line to serve
+//		bool m_paced -- keep to the recorded times
+//		steady_clock::time_point m_start -- when the replay began
+//		uint64_t m_waitNanos -- time spent waiting to keep pace
+//		string m_line -- the line being served
+//
+//	  Methods:
+//		CReplayBuf(const std::vector<TraceLine>& lines, bool paced);
+//		bool done() const -- every line has been served
+//		uint64_t waitNanos() const
+//		static bool read(const char* traceName,
+//			std::vector<TraceLine>& lines);
+//		protected: int_type underflow();
+//
+//	  class CNullBuf:
+//		protected: int_type overflow(int_type c);
+//		protected: std::streamsize xsputn(const char* s, std::streamsize n);
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	struct TraceLine
+	{
+		uint64_t micros;
+		std::string text;
+	};
+
+	class CRecordBuf : public std::streambuf
+	{
+	public:
+		CRecordBuf(std::streambuf* source, const char* traceName);
+		bool isOpen() const { return m_trace.is_open(); }
+
+	protected:
+		int_type underflow();
+
+	private:
+		std::streambuf* m_source;
+		std::ofstream m_trace;
+		std::chrono::steady_clock::time_point m_start;
+		std::string m_line;
+	};
+
+	class CReplayBuf : public std::streambuf
+	{
+	public:
+		CReplayBuf(const std::vector<TraceLine>& lines, bool paced);
+		bool done() const
+			{ return m_next == m_lines.size() && gptr() == egptr(); }
+		uint64_t waitNanos() const { return m_waitNanos; }
+		static bool read(const char* traceName, std::vector<TraceLine>& lines);
+
+	protected:
+		int_type underflow();
+
+	private:
+		const std::vector<TraceLine>& m_lines;
+		size_t m_next;
+		bool m_paced;
+		std::chrono::steady_clock::time_point m_start;
+		uint64_t m_waitNanos;
+		std::string m_line;
+	};
+
+	class CNullBuf : public std::streambuf
+	{
+	protected:
+		int_type overflow(int_type c) { return traits_type::not_eof(c); }
+		std::streamsize xsputn(const char*, std::streamsize n) { return n; }
+	};
+} // end namespace TPUS_CALC
+
+#endif
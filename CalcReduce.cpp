@@ -0,0 +1,190 @@
+//----------------------------------------------------------------------------
+//    File:       CalcReduce.cpp
+//
+//    Description: This file contains the stack reduction kernels
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcReduce.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	// A compensated sum: the value is sum - comp.
+	struct KSum
+	{
+		double sum;
+		double comp;
+	};
+
+	static inline void kahanAdd(KSum& k, double x)
+	{
+		double y = x - k.comp;
+		double t = k.sum + y;
+		k.comp = (t - k.sum) - y;
+		k.sum = t;
+	}
+
+	//------------------------------------------------------------------------
+	//	Function:		kahanKernel(size_t begin, size_t end, Term term)
+	//	Description:	Compensated sum of term(i) for i in [begin, end).
+	//						Each of the REDUCE_LANES lanes is its own Kahan
+	//						sum, so the inner loop has no dependency across
+	//						lanes and is vectorized; no reassociation is
+	//						needed, so this holds without -ffast-math (which
+	//						must not be used, as it would remove the
+	//						compensation).
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	template <class Term>
+	static KSum kahanKernel(size_t begin, size_t end, Term term)
+	{
+		double s[REDUCE_LANES] = { 0 };
+		double c[REDUCE_LANES] = { 0 };
+		size_t i = begin;
+		for (; i + REDUCE_LANES <= end; i += REDUCE_LANES)
+			for (size_t l = 0; l < REDUCE_LANES; l++)
+			{
+				double y = term(i + l) - c[l];
+				double t = s[l] + y;
+				c[l] = (t - s[l]) - y;
+				s[l] = t;
+			}
+		KSum total = { 0.0, 0.0 };
+		for (; i < end; i++)
+			kahanAdd(total, term(i));
+		for (size_t l = 0; l < REDUCE_LANES; l++)
+		{
+			kahanAdd(total, s[l]);
+			kahanAdd(total, -c[l]);
+		}
+		return total;
+	}
+
+	//------------------------------------------------------------------------
+	//	Function:		runChunks(size_t n, vector<Result>& parts, kernel)
+	//	Description:	Runs kernel(begin, end) over [0, n), one chunk per
+	//						thread when n is at least PARALLEL_MIN (the
+	//						calling thread takes the first chunk), and
+	//						leaves each chunk's result in parts.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	template <class Result, class Kernel>
+	static void runChunks(size_t n, vector<Result>& parts, Kernel kernel)
+	{
+		size_t threads = 1;
+		if (n >= PARALLEL_MIN)
+		{
+			threads = max(1u, thread::hardware_concurrency());
+			threads = min(threads, n / (PARALLEL_MIN / 4));
+		}
+		size_t chunk = (n / threads + REDUCE_LANES - 1)
+			/ REDUCE_LANES * REDUCE_LANES;
+		vector<thread> pool;
+		parts.resize(threads);
+		for (size_t t = 1; t < threads; t++)
+		{
+			size_t begin = min(n, t * chunk);
+			size_t end = (t + 1 == threads) ? n : min(n, begin + chunk);
+			pool.push_back(thread([&parts, &kernel, t, begin, end]()
+				{ parts[t] = kernel(begin, end); }));
+		}
+		parts[0] = kernel(0, (threads == 1) ? n : min(n, chunk));
+		for (size_t t = 0; t < pool.size(); t++)
+			pool[t].join();
+	}
+
+	template <class Term>
+	static double compensatedSum(size_t n, Term term)
+	{
+		vector<KSum> parts;
+		runChunks(n, parts, [&term](size_t begin, size_t end)
+			{ return kahanKernel(begin, end, term); });
+		KSum total = { 0.0, 0.0 };
+		for (size_t t = 0; t < parts.size(); t++)
+		{
+			kahanAdd(total, parts[t].sum);
+			kahanAdd(total, -parts[t].comp);
+		}
+		return total.sum - total.comp;
+	}
+
+	template <class Pick>
+	static double extreme(const double* data, size_t n, Pick pick)
+	{
+		vector<double> parts;
+		runChunks(n, parts, [data, &pick](size_t begin, size_t end)
+		{
+			double m[REDUCE_LANES];
+			size_t i = begin;
+			fill(m, m + REDUCE_LANES, data[begin]);
+			for (; i + REDUCE_LANES <= end; i += REDUCE_LANES)
+				for (size_t l = 0; l < REDUCE_LANES; l++)
+					m[l] = pick(data[i + l], m[l]);
+			for (; i < end; i++)
+				m[0] = pick(data[i], m[0]);
+			for (size_t l = 1; l < REDUCE_LANES; l++)
+				m[0] = pick(m[l], m[0]);
+			return m[0];
+		});
+		double result = parts[0];
+		for (size_t t = 1; t < parts.size(); t++)
+			result = pick(parts[t], result);
+		return result;
+	}
+
+	//------------------------------------------------------------------------
+	//	Functions:		reduceSum(), reduceMean(), reduceVariance(),
+	//					reduceMin(), reduceMax(), reduceDot()
+	//	Description:	Sum, mean, sample variance, minimum and maximum of
+	//						data[0..n), and the dot product of x and y.
+	//						n must be at least 1 (2 for the variance).
+	//	Programmers:	David Landry
+	//	Called by:		CRPNCalc::reduce()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	double reduceSum(const double* data, size_t n)
+	{
+		return compensatedSum(n, [data](size_t i) { return data[i]; });
+	}
+
+	double reduceMean(const double* data, size_t n)
+	{
+		return reduceSum(data, n) / n;
+	}
+
+	double reduceVariance(const double* data, size_t n)
+	{
+		double mean = reduceMean(data, n);
+		return compensatedSum(n, [data, mean](size_t i)
+			{ return (data[i] - mean) * (data[i] - mean); }) / (n - 1);
+	}
+
+	double reduceMin(const double* data, size_t n)
+	{
+		return extreme(data, n, [](double a, double b)
+			{ return a < b ? a : b; });
+	}
+
+	double reduceMax(const double* data, size_t n)
+	{
+		return extreme(data, n, [](double a, double b)
+			{ return a > b ? a : b; });
+	}
+
+	double reduceDot(const double* x, const double* y, size_t n)
+	{
+		return compensatedSum(n, [x, y](size_t i) { return x[i] * y[i]; });
+	}
+} // end namespace TPUS_CALC
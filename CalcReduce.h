@@ -0,0 +1,45 @@
+//----------------------------------------------------------------------------
+//    File:		CalcReduce.h
+//
+//    Functions:	reduceSum(), reduceMean(), reduceVariance(),
+//					reduceMin(), reduceMax(), reduceDot()
+//----------------------------------------------------------------------------
+#ifndef CALCREDUCE_H
+#define CALCREDUCE_H
+
+#include <cstddef>
+//----------------------------------------------------------------------------
+//
+//    Title:		Stack reduction kernels
+//
+//    Description:	Reductions over a contiguous block of doubles.  Sums
+//						use Kahan compensated summation kept in REDUCE_LANES
+//						independent lanes, which the compiler turns into
+//						vector instructions; the variance is two-pass (mean,
+//						then squared deviations) so it does not cancel.
+//						Blocks of at least PARALLEL_MIN values are split
+//						across hardware threads and the partial results
+//						combined, again with compensation.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	const size_t REDUCE_LANES = 8;
+	const size_t PARALLEL_MIN = 1 << 20;	// values before threads are used
+
+	double reduceSum(const double* data, size_t n);
+	double reduceMean(const double* data, size_t n);
+	double reduceVariance(const double* data, size_t n);	// sample, n > 1
+	double reduceMin(const double* data, size_t n);
+	double reduceMax(const double* data, size_t n);
+	double reduceDot(const double* x, const double* y, size_t n);
+} // end namespace TPUS_CALC
+
+#endif
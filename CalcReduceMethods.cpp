@@ -0,0 +1,87 @@
+#include "RPNCalc.h"
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			reduce(cmd thecmd)
+	//	Description:	Replaces entries with one summary value in a single
+	//						pass over contiguous memory, instead of the N-1
+	//						binary operations it would take by hand.
+	//						SUM, MEAN, VAR, MIN and MAX use the whole stack.
+	//						NSUM, NMEAN, NVAR, NMIN and NMAX pop a count n
+	//						first and use the n entries under it.  n DOT
+	//						pops n, then takes the top n entries as x and
+	//						the n below them as y and pushes x . y.  A bad
+	//						count, too few entries or a matrix or complex
+	//						value among them sets the error flag and
+	//						leaves the stack as it was.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- which reduction
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			CCalcStack::contiguous(); reduceSum() etc.;
+	//						stackTouched()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, rejecting
+	//									matrix and complex operands.
+	//------------------------------------------------------------------------
+	void CRPNCalc::reduce(cmd thecmd)
+	{
+		size_t skip = 0;				// the count, if there is one
+		size_t n = m_stack.size();
+		size_t used = n;
+
+		if (thecmd >= NSUM)
+		{
+			double count = m_stack.empty() ? 0.0 : m_stack.front();
+			skip = 1;
+			n = (count >= 1 && count == floor(count)
+				&& count < m_stack.size()) ? static_cast<size_t>(count) : 0;
+			used = (thecmd == DOT) ? 2 * n : n;
+		}
+		if (n == 0 || skip + used > m_stack.size()
+			|| ((thecmd == RVAR || thecmd == NVAR) && n < 2))
+		{
+			m_error = true;
+			return;
+		}
+
+		const double* data = m_stack.contiguous() + skip;
+		for (size_t i = 0; i < used; i++)
+			if (isBoxed(data[i]))
+			{
+				m_error = true;
+				return;
+			}
+		double result;
+		switch (thecmd)
+		{
+		case RSUM: case NSUM:
+			result = reduceSum(data, n);
+			break;
+		case RMEAN: case NMEAN:
+			result = reduceMean(data, n);
+			break;
+		case RVAR: case NVAR:
+			result = reduceVariance(data, n);
+			break;
+		case RMIN: case NMIN:
+			result = reduceMin(data, n);
+			break;
+		case RMAX: case NMAX:
+			result = reduceMax(data, n);
+			break;
+		default:
+			result = reduceDot(data, data + n, n);
+			break;
+		}
+		m_stack.pop_front(skip + used);
+		stackTouched(m_stack.size());
+		// A NaN result can carry a boxed value's bits; never push one.
+		m_stack.push_front(isBoxed(result) ? NAN : result);
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,123 @@
+#include "RPNCalc.h"
+#include <chrono>
+#include <iomanip>
+namespace TPUS_CALC
+{
+	// The sample at fraction p of the way through sorted samples
+	//	(nearest rank).
+	static double percentile(const vector<double>& sorted, double p)
+	{
+		size_t rank = static_cast<size_t>(ceil(p * sorted.size()));
+		return sorted[rank ? rank - 1 : 0];
+	}
+
+	static void reportRow(ostream& report, const string& name,
+		vector<double>& samples)
+	{
+		sort(samples.begin(), samples.end());
+		report << left << setw(10) << name << right
+			<< setw(10) << samples.size()
+			<< setw(12) << percentile(samples, 0.5)
+			<< setw(12) << percentile(samples, 0.99)
+			<< setw(12) << percentile(samples, 0.999)
+			<< setw(12) << samples.back() << '\n';
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			replaySession(const vector<TraceLine>& lines,
+	//						bool paced, ostream& report)
+	//	Description:	Plays a recorded session back through the calculator
+	//						with nothing on the screen: the trace stands in
+	//						for the keyboard (cin, so prompts get their
+	//						recorded answers too) and the screen and every
+	//						prompt go to a CNullBuf.  Each input line is
+	//						timed from reading it to having redrawn the
+	//						screen, less any time spent waiting to keep
+	//						pace, and filed under its command.  The report
+	//						gives the throughput and, per command and
+	//						overall, the count and the p50, p99, p99.9 and
+	//						worst latencies in microseconds.  Any files
+	//						the session loads or saves are used as they
+	//						are now, relative to the current directory.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		const vector<TraceLine>& lines -- the trace
+	//					bool paced -- keep to the recorded times instead
+	//						of going flat out
+	//					ostream& report -- where the results go
+	//	Returns:		None
+	//	Called by:		runReplayMode()
+	//	Calls:			print(); input()
+	//	Input:			The trace.
+	//	Output:			The report.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::replaySession(const vector<TraceLine>& lines, bool paced,
+		ostream& report)
+	{
+		typedef chrono::steady_clock Clock;
+		CReplayBuf keyboard(lines, paced);
+		CNullBuf screen;
+		istream replayIn(&keyboard);
+		ostream replayOut(&screen);
+		streambuf* savedIn = cin.rdbuf(&keyboard);
+		streambuf* savedOut = cout.rdbuf(&screen);
+		vector<vector<double> > samples(NUMCMDS);
+		size_t commands = 0;
+
+		m_on = ON;
+		print(replayOut);
+		Clock::time_point begin = Clock::now();
+		while (m_on == ON && !keyboard.done())
+		{
+			uint64_t waited = keyboard.waitNanos();
+			Clock::time_point start = Clock::now();
+			input(replayIn);
+			print(replayOut);
+			double nanos = static_cast<double>(
+				chrono::duration_cast<chrono::nanoseconds>(
+				Clock::now() - start).count());
+			nanos -= keyboard.waitNanos() - waited;
+			samples[m_lineCmd].push_back(nanos / 1000.0);
+			commands++;
+		}
+		double seconds = chrono::duration_cast<chrono::nanoseconds>(
+			Clock::now() - begin).count() / 1e9
+			- keyboard.waitNanos() / 1e9;
+		cin.rdbuf(savedIn);
+		cout.rdbuf(savedOut);
+
+		// Name each command after its keyword.
+		vector<string> names(NUMCMDS);
+		for (RPNmap::const_iterator it = m_map.begin(); it != m_map.end();
+			++it)
+			if (names[it->second].empty())
+				names[it->second] = it->first;
+		names[NOVAL] = "(none)";
+		names[PUSH] = "(number)";
+		names[GETN] = "G:name";
+		names[SETN] = "S:name";
+		names[LOADN] = "L:name";
+
+		report << "Replayed " << lines.size() << " lines as " << commands
+			<< " commands in " << seconds << " s ("
+			<< (seconds > 0 ? commands / seconds : 0.0)
+			<< " commands/s" << (paced ? ", paced" : "") << ")\n";
+		report << left << setw(10) << "command" << right << setw(10)
+			<< "count" << setw(12) << "p50 us" << setw(12) << "p99 us"
+			<< setw(12) << "p99.9 us" << setw(12) << "max us" << '\n';
+		vector<double> all;
+		for (int c = 0; c < NUMCMDS; c++)
+		{
+			if (samples[c].empty())
+				continue;
+			all.insert(all.end(), samples[c].begin(), samples[c].end());
+			reportRow(report, names[c].empty() ? "?" : names[c], samples[c]);
+		}
+		if (!all.empty())
+			reportRow(report, "(all)", all);
+		report.flush();
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,326 @@
+//----------------------------------------------------------------------------
+//    Class:		CResultSink
+//
+//    File:       CalcResultSink.cpp
+//
+//    Description: This file contains the function definitions for
+//					CResultSink
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcResultSink.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <string>
+#ifdef _WIN32
+#include <io.h>
+#include <sys/stat.h>
+#define SYS_WRITE ::_write
+#define SYS_LSEEK ::_lseeki64
+#define SYS_CLOSE ::_close
+#else
+#include <unistd.h>
+#define SYS_WRITE ::write
+#define SYS_LSEEK ::lseek
+#define SYS_CLOSE ::close
+#endif
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	const size_t PAGE = 4096;		// buffer alignment and size granule
+
+	static size_t roundUp(size_t n, size_t to)
+	{
+		return (n + to - 1) / to * to;
+	}
+
+	// write(2) until everything is out or it fails.
+	static bool writeAll(int fd, const char* data, size_t size)
+	{
+		while (size > 0)
+		{
+			long done = static_cast<long>(SYS_WRITE(fd, data,
+				static_cast<unsigned>(size)));
+			if (done < 0 && errno == EINTR)
+				continue;
+			if (done <= 0)
+				return false;
+			data += done;
+			size -= done;
+		}
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			CResultSink()
+	//	Description:	Creates a closed sink.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CResultSink::CResultSink() : m_fd(-1), m_bufferSize(0), m_current(0),
+		m_totalRows(0), m_failed(false), m_stopping(false)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			~CResultSink()
+	//	Description:	Closes the sink if it is still open.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CResultSink::~CResultSink()
+	{
+		close();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			open(const char* fileName, registers, threaded)
+	//	Description:	Creates the file, writes its header and sets up the
+	//						row group buffers (and the writer thread).
+	//	Programmers:	David Landry
+	//	Parameters:		const char* fileName -- the output file
+	//					const vector<int>& registers -- registers (0 - 9)
+	//						to write as columns after the top of the stack
+	//					bool threaded -- write on a separate thread
+	//	Returns:		bool -- true if the file was created
+	//	Called by:		main()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CResultSink::open(const char* fileName, const vector<int>& registers,
+		bool threaded)
+	{
+		SinkHeader header;
+		vector<SinkColumn> columns(registers.size() + 2);
+
+		close();
+#ifdef _WIN32
+		m_fd = _open(fileName, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+			_S_IREAD | _S_IWRITE);
+#else
+		m_fd = ::open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+		if (m_fd < 0)
+			return false;
+		m_registers = registers;
+		m_totalRows = 0;
+		m_failed = false;
+		m_stopping = false;
+
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, "RPNCOLS", 8);
+		header.version = SINK_VERSION;
+		header.byteOrder = 0x01020304;
+		header.columns = static_cast<uint32_t>(columns.size());
+		header.groupRows = GROUP_ROWS;
+		memset(&columns[0], 0, columns.size() * sizeof(SinkColumn));
+		m_offsets.clear();
+		size_t offset = sizeof(uint64_t);		// the group's row count
+		for (size_t c = 0; c < columns.size(); c++)
+		{
+			string name = (c == 0) ? "top" : (c + 1 == columns.size())
+				? "error" : "R" + to_string(registers[c - 1]);
+			strncpy(columns[c].name, name.c_str(),
+				sizeof(columns[c].name) - 1);
+			columns[c].type = (c + 1 == columns.size()) ? SINK_U8 : SINK_F64;
+			columns[c].width = (columns[c].type == SINK_U8) ? 1 : 8;
+			m_offsets.push_back(offset);
+			offset += roundUp(GROUP_ROWS * columns[c].width, 8);
+		}
+		m_bufferSize = roundUp(offset, PAGE);
+		if (!writeAll(m_fd, reinterpret_cast<const char*>(&header),
+			sizeof(header)) || !writeAll(m_fd,
+				reinterpret_cast<const char*>(&columns[0]),
+				columns.size() * sizeof(SinkColumn)))
+			m_failed = true;
+
+		m_groups.resize(threaded ? BUFFERS : 1);
+		m_free.clear();
+		for (size_t g = 0; g < m_groups.size(); g++)
+		{
+			m_groups[g].data = static_cast<char*>(
+				operator new(m_bufferSize, align_val_t(PAGE)));
+			m_groups[g].rows = 0;
+			m_free.push_back(&m_groups[g]);
+		}
+		m_current = takeFree();
+		if (threaded)
+			m_writer = thread(&CResultSink::writerLoop, this);
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			append(double top, const double* registers, bool error)
+	//	Description:	Adds one row.
+	//	Programmers:	David Landry
+	//	Parameters:		double top -- the top of the stack (NaN if empty)
+	//					const double* registers -- all ten registers
+	//					bool error -- the row's error flag
+	//	Called by:		CRPNCalc::runBatch()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CResultSink::append(double top, const double* registers, bool error)
+	{
+		char* data = m_current->data;
+		size_t row = m_current->rows;
+
+		reinterpret_cast<double*>(data + m_offsets[0])[row] = top;
+		for (size_t r = 0; r < m_registers.size(); r++)
+			reinterpret_cast<double*>(data + m_offsets[r + 1])[row]
+				= registers[m_registers[r]];
+		data[m_offsets.back() + row] = error ? 1 : 0;
+		m_totalRows++;
+		if (++m_current->rows == GROUP_ROWS)
+		{
+			submit(m_current);
+			m_current = takeFree();
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			close()
+	//	Description:	Writes the last, partial row group, waits for the
+	//						writer thread, fills in the row count and closes
+	//						the file.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- true if everything was written
+	//	Called by:		main(); ~CResultSink()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CResultSink::close()
+	{
+		if (m_fd < 0)
+			return false;
+		if (m_current->rows > 0)
+			submit(m_current);
+		m_current = 0;
+		if (m_writer.joinable())
+		{
+			{
+				lock_guard<mutex> guard(m_lock);
+				m_stopping = true;
+			}
+			m_changed.notify_all();
+			m_writer.join();
+		}
+		if (SYS_LSEEK(m_fd, offsetof(SinkHeader, totalRows), SEEK_SET) < 0
+			|| !writeAll(m_fd, reinterpret_cast<const char*>(&m_totalRows),
+				sizeof(m_totalRows)))
+			m_failed = true;
+		SYS_CLOSE(m_fd);
+		m_fd = -1;
+		for (size_t g = 0; g < m_groups.size(); g++)
+			operator delete(m_groups[g].data, align_val_t(PAGE));
+		m_groups.clear();
+		m_free.clear();
+		m_full.clear();
+		return !m_failed;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			submit(Group* group)
+	//	Description:	Queues a filled buffer for the writer thread, or
+	//						writes it right away if there is none.
+	//	Programmers:	David Landry
+	//	Called by:		append(); close()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CResultSink::submit(Group* group)
+	{
+		if (!m_writer.joinable())
+		{
+			writeGroup(group);
+			m_free.push_back(group);
+			return;
+		}
+		{
+			lock_guard<mutex> guard(m_lock);
+			m_full.push_back(group);
+		}
+		m_changed.notify_all();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			takeFree()
+	//	Description:	Gets an empty buffer, waiting for the writer thread
+	//						if every buffer is queued.
+	//	Programmers:	David Landry
+	//	Called by:		open(); append()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CResultSink::Group* CResultSink::takeFree()
+	{
+		unique_lock<mutex> lock(m_lock);
+		m_changed.wait(lock, [this]() { return !m_free.empty(); });
+		Group* group = m_free.back();
+		m_free.pop_back();
+		group->rows = 0;
+		return group;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			writeGroup(Group* group)
+	//	Description:	Writes one row group.  A partial group is packed
+	//						first, moving each column down to follow the
+	//						previous one, so it still goes out in one write.
+	//	Programmers:	David Landry
+	//	Called by:		submit(); writerLoop()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CResultSink::writeGroup(Group* group)
+	{
+		uint64_t rows = group->rows;
+		size_t packed = sizeof(uint64_t);
+
+		memcpy(group->data, &rows, sizeof(rows));
+		for (size_t c = 0; c < m_offsets.size(); c++)
+		{
+			size_t width = (c + 1 == m_offsets.size()) ? 1 : 8;
+			size_t bytes = rows * width;
+			if (packed != m_offsets[c])
+				memmove(group->data + packed, group->data + m_offsets[c],
+					bytes);
+			memset(group->data + packed + bytes, 0,
+				roundUp(bytes, 8) - bytes);
+			packed += roundUp(bytes, 8);
+		}
+		if (!writeAll(m_fd, group->data, packed))
+			m_failed = true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			writerLoop()
+	//	Description:	The writer thread: writes queued buffers in order
+	//						and hands them back, until close() asks it to
+	//						stop and the queue is empty.
+	//	Programmers:	David Landry
+	//	Called by:		open() (as a thread)
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CResultSink::writerLoop()
+	{
+		unique_lock<mutex> lock(m_lock);
+		for (;;)
+		{
+			m_changed.wait(lock,
+				[this]() { return !m_full.empty() || m_stopping; });
+			if (m_full.empty())
+				return;
+			Group* group = m_full.front();
+			m_full.pop_front();
+			lock.unlock();
+			writeGroup(group);
+			lock.lock();
+			m_free.push_back(group);
+			m_changed.notify_all();
+		}
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------
+//    File:		CalcResultSink.h
+//
+//    Class:	CResultSink
+//----------------------------------------------------------------------------
+#ifndef CALCRESULTSINK_H
+#define CALCRESULTSINK_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		CResultSink Class
+//
+//    Description:	Writes batch results as a columnar binary file instead
+//						of text.  Each row is the top of the stack, the
+//						selected registers and the error flag.  Rows are
+//						gathered into row groups of GROUP_ROWS rows, one
+//						column after another, in page-aligned buffers that
+//						go to the file with a single write(2) each.  With
+//						a writer thread the full groups are handed off
+//						and written while evaluation carries on filling
+//						the next buffer; evaluation only waits if all
+//						BUFFERS buffers are queued.
+//
+//						File layout (native byte order, given by the
+//						byteOrder field):
+//							SinkHeader
+//							SinkColumn x columns
+//							row groups: uint64 rows, then each column's
+//								rows values, each column padded to 8 bytes
+//						totalRows is filled in when the sink is closed.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  struct SinkHeader, SinkColumn -- the file header
+//
+//	  class CResultSink:
+//
+//	  Properties:
+//		int m_fd -- the output file (-1 if closed)
+//		vector<int> m_registers -- registers written after the top
+//		vector<size_t> m_offsets -- where each column starts in a buffer
+//		size_t m_bufferSize -- bytes in each buffer
+//		vector<Group> m_groups -- the buffers
+//		Group* m_current -- the buffer being filled
+//		uint64_t m_totalRows -- rows appended so far
+//		bool m_failed -- a write failed
+//		thread m_writer -- the writer thread, if used
+//		mutex m_lock -- guards the queues below
+//		condition_variable m_changed -- signals queue changes
+//		deque<Group*> m_full -- buffers waiting to be written
+//		vector<Group*> m_free -- buffers ready to be filled
+//		bool m_stopping -- the writer thread should finish up
+//
+//	  Methods:
+//
+//		inline:
+//			bool isOpen() const
+//
+//		non-inline:
+//			CResultSink();
+//			~CResultSink();
+//			bool open(const char* fileName, const vector<int>& registers,
+//				bool threaded);
+//			void append(double top, const double* registers, bool error);
+//			bool close();
+//		private:
+//			void submit(Group* group);
+//			Group* takeFree();
+//			void writeGroup(Group* group);
+//			void writerLoop();
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	const uint32_t SINK_VERSION = 1;
+	const uint32_t SINK_F64 = 0;		// column types
+	const uint32_t SINK_U8 = 1;
+
+	struct SinkHeader
+	{
+		char magic[8];				// "RPNCOLS\0"
+		uint32_t version;
+		uint32_t byteOrder;			// 0x01020304 as written
+		uint32_t columns;
+		uint32_t groupRows;
+		uint64_t totalRows;
+	};
+
+	struct SinkColumn
+	{
+		char name[16];
+		uint32_t type;
+		uint32_t width;				// bytes per value
+	};
+
+	class CResultSink
+	{
+	public:
+		static const size_t GROUP_ROWS = 8192;
+		static const size_t BUFFERS = 4;
+
+		CResultSink();
+		~CResultSink();
+		bool open(const char* fileName, const std::vector<int>& registers,
+			bool threaded);
+		void append(double top, const double* registers, bool error);
+		bool close();
+		bool isOpen() const { return m_fd >= 0; }
+
+	private:
+		struct Group
+		{
+			char* data;
+			size_t rows;
+		};
+
+		CResultSink(const CResultSink&);				// not copyable
+		CResultSink& operator=(const CResultSink&);
+		void submit(Group* group);
+		Group* takeFree();
+		void writeGroup(Group* group);
+		void writerLoop();
+
+		int m_fd;
+		std::vector<int> m_registers;
+		std::vector<size_t> m_offsets;
+		size_t m_bufferSize;
+		std::vector<Group> m_groups;
+		Group* m_current;
+		uint64_t m_totalRows;
+		bool m_failed;
+		std::thread m_writer;
+		std::mutex m_lock;
+		std::condition_variable m_changed;
+		std::deque<Group*> m_full;
+		std::vector<Group*> m_free;
+		bool m_stopping;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,121 @@
+//----------------------------------------------------------------------------
+//    Class:		CSharedBank
+//
+//    File:       CalcShared.cpp
+//
+//    Description: This file contains the function definitions for
+//					CSharedBank
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcShared.h"
+#include <cstring>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	static_assert(atomic<uint64_t>::is_always_lock_free,
+		"the shared registers need lock-free 64-bit atomics");
+	static_assert(sizeof(SharedSlot) == CACHE_LINE,
+		"a shared register must fill its cache line");
+
+	static uint64_t toBits(double value)
+	{
+		uint64_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	static double fromBits(uint64_t bits)
+	{
+		double value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			instance()
+	//	Description:	The process's bank, made (all zero) on first use.
+	//	Programmers:	David Landry
+	//	Returns:		CSharedBank& -- the bank
+	//	Called by:		CRPNCalc's register methods
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CSharedBank& CSharedBank::instance()
+	{
+		static CSharedBank bank;
+		return bank;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			CSharedBank()
+	//	Description:	Sets every slot to 0.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CSharedBank::CSharedBank()
+	{
+		for (size_t i = 0; i < SLOTS; i++)
+			m_slots[i].bits.store(toBits(0.0), memory_order_relaxed);
+	}
+
+	//------------------------------------------------------------------------
+	//	Methods:		load(size_t slot), store(size_t slot, double value)
+	//	Description:	Read and write a slot.  A store is visible to any
+	//						later load of the slot in any thread, along
+	//						with everything the storing thread did before.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	double CSharedBank::load(size_t slot) const
+	{
+		return fromBits(m_slots[slot].bits.load(memory_order_acquire));
+	}
+
+	void CSharedBank::store(size_t slot, double value)
+	{
+		m_slots[slot].bits.store(toBits(value), memory_order_release);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			compareExchange(size_t slot, double expected,
+	//						double desired)
+	//	Description:	Sets the slot to desired if it holds expected.
+	//	Programmers:	David Landry
+	//	Returns:		double -- the value the slot held; the exchange
+	//						happened if it is (bitwise) expected
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	double CSharedBank::compareExchange(size_t slot, double expected,
+		double desired)
+	{
+		uint64_t seen = toBits(expected);
+		m_slots[slot].bits.compare_exchange_strong(seen, toBits(desired),
+			memory_order_acq_rel, memory_order_acquire);
+		return fromBits(seen);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			fetchAdd(size_t slot, double addend)
+	//	Description:	Adds to the slot atomically, retrying if another
+	//						thread changed it in between.
+	//	Programmers:	David Landry
+	//	Returns:		double -- the value before the add
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	double CSharedBank::fetchAdd(size_t slot, double addend)
+	{
+		uint64_t seen = m_slots[slot].bits.load(memory_order_relaxed);
+		while (!m_slots[slot].bits.compare_exchange_weak(seen,
+			toBits(fromBits(seen) + addend),
+			memory_order_acq_rel, memory_order_relaxed))
+			;
+		return fromBits(seen);
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,85 @@
+//----------------------------------------------------------------------------
+//    File:		CalcShared.h
+//
+//    Class:	CSharedBank
+//----------------------------------------------------------------------------
+#ifndef CALCSHARED_H
+#define CALCSHARED_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+//----------------------------------------------------------------------------
+//
+//    Title:		CSharedBank Class
+//
+//    Description:	A bank of registers shared by every calculator in the
+//						process, whichever thread runs it.  Each slot is a
+//						64-bit atomic holding a double's bits, alone on
+//						its own cache line so sessions hammering
+//						neighbouring slots do not slow each other down.
+//						Loads and stores are single atomic operations;
+//						compareExchange() and fetchAdd() are the
+//						coordination primitives (fetchAdd() is a
+//						compare-and-swap loop, since there is no atomic
+//						floating-point add).  Nothing here takes a lock.
+//
+//						compareExchange() compares bits, so it matches
+//						-0 only with -0 and a NaN with the same NaN.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  struct SharedSlot:
+//		atomic<uint64_t> bits -- the value, padded to a cache line
+//
+//	  class CSharedBank:
+//
+//	  Properties:
+//		SharedSlot m_slots[SLOTS] -- the registers
+//
+//	  Methods:
+//
+//		non-inline:
+//			static CSharedBank& instance();
+//			double load(size_t slot) const;
+//			void store(size_t slot, double value);
+//			double compareExchange(size_t slot, double expected,
+//				double desired);
+//			double fetchAdd(size_t slot, double addend);
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	const size_t CACHE_LINE = 64;
+
+	struct alignas(CACHE_LINE) SharedSlot
+	{
+		std::atomic<uint64_t> bits;
+	};
+
+	class CSharedBank
+	{
+	public:
+		static const size_t SLOTS = 256;
+
+		static CSharedBank& instance();
+		double load(size_t slot) const;
+		void store(size_t slot, double value);
+		double compareExchange(size_t slot, double expected, double desired);
+		double fetchAdd(size_t slot, double addend);
+
+	private:
+		CSharedBank();
+		CSharedBank(const CSharedBank&);				// not copyable
+		CSharedBank& operator=(const CSharedBank&);
+
+		SharedSlot m_slots[SLOTS];
+	};
+} // end namespace TPUS_CALC
+
+#endif
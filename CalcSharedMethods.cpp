@@ -0,0 +1,187 @@
+#include "RPNCalc.h"
+namespace TPUS_CALC
+{
+	// Reads a whole number in [0, limit) off the stack.
+	static bool indexOperand(double value, size_t limit, int& index)
+	{
+		if (!(value >= 0 && value < limit && value == floor(value)))
+			return false;
+		index = static_cast<int>(value);
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			getRegister(int reg)
+	//	Description:	The value of a register: from the shared bank if the
+	//						register is mapped to it, otherwise private.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		int reg -- the register (0 - 9)
+	//	Returns:		double -- its value
+	//	Called by:		getReg(); registerValues(); sharedOp()
+	//	Calls:			CSharedBank::load()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	double CRPNCalc::getRegister(int reg) const
+	{
+		return (m_shared[reg] < 0) ? m_registers[reg]
+			: CSharedBank::instance().load(m_shared[reg]);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			registerValues(double* values)
+	//	Description:	Copies the values of all NUMREGS registers.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		double* values -- receives NUMREGS values
+	//	Returns:		None
+	//	Called by:		runBatch(); runDual()
+	//	Calls:			getRegister()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::registerValues(double* values) const
+	{
+		for (int i = 0; i < NUMREGS; i++)
+			values[i] = getRegister(i);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			mapRegister()
+	//	Description:	MAP: "r s MAP" maps register r to slot s of the
+	//						shared bank, so G and S on it read and write
+	//						the slot, as do those of every other session
+	//						mapped to it.  The register takes the slot's
+	//						value.  A mapped register is not part of undo,
+	//						snapshots or checkpoints; those keep the
+	//						private value it had.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			stackTouched()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::mapRegister()
+	{
+		int reg;
+		int slot;
+		if (m_stack.size() < 2
+			|| !indexOperand(m_stack[0], CSharedBank::SLOTS, slot)
+			|| !indexOperand(m_stack[1], NUMREGS, reg))
+		{
+			m_error = true;
+			return;
+		}
+		m_stack.pop_front(2);
+		stackTouched(m_stack.size());
+		m_shared[reg] = slot;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			unmapRegister()
+	//	Description:	UNMAP: "r UNMAP" makes register r private again,
+	//						keeping the shared slot's current value.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			getRegister(); stackTouched()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::unmapRegister()
+	{
+		int reg;
+		if (m_stack.empty() || !indexOperand(m_stack[0], NUMREGS, reg))
+		{
+			m_error = true;
+			return;
+		}
+		m_stack.pop_front();
+		stackTouched(m_stack.size());
+		m_registers[reg] = getRegister(reg);
+		m_shared[reg] = -1;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			sharedOp(cmd thecmd)
+	//	Description:	CAS: "expected new r CAS" sets register r to new if
+	//						it holds expected.  FADD: "x r FADD" adds x to
+	//						register r.  Either pushes the value r held
+	//						before; on a mapped register the operation is
+	//						one atomic step, so sessions racing on it each
+	//						see a different old value.  FADD on a
+	//						register holding a matrix or complex value is
+	//						an error.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- CAS or FADD
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			CSharedBank::compareExchange();
+	//						CSharedBank::fetchAdd(); stackTouched()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, rejecting FADD
+	//									on a boxed register.
+	//------------------------------------------------------------------------
+	void CRPNCalc::sharedOp(cmd thecmd)
+	{
+		size_t operands = (thecmd == CAS) ? 3 : 2;
+		int reg;
+		double old;
+		if (m_stack.size() < operands
+			|| !indexOperand(m_stack[0], NUMREGS, reg)
+			|| isBoxed(m_stack[1]) || isBoxed(m_stack[operands - 1]))
+		{
+			m_error = true;
+			return;
+		}
+		double operand = m_stack[1];		// new value, or addend
+		double expected = (thecmd == CAS) ? m_stack[2] : 0.0;
+		// Adding to a matrix or complex handle would corrupt it.
+		if (thecmd == FADD && m_shared[reg] < 0 && isBoxed(m_registers[reg]))
+		{
+			m_error = true;
+			return;
+		}
+		if (m_shared[reg] >= 0)
+		{
+			CSharedBank& bank = CSharedBank::instance();
+			old = (thecmd == CAS)
+				? bank.compareExchange(m_shared[reg], expected, operand)
+				: bank.fetchAdd(m_shared[reg], operand);
+		}
+		else
+		{
+			old = m_registers[reg];
+			if (thecmd == FADD)
+				m_registers[reg] += operand;
+			else if (memcmp(&old, &expected, sizeof(old)) == 0)
+				m_registers[reg] = operand;
+		}
+		m_stack.pop_front(operands);
+		stackTouched(m_stack.size());
+		m_stack.push_front(old);
+	}
+} // end namespace TPUS_CALC
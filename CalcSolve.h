@@ -0,0 +1,267 @@
+//----------------------------------------------------------------------------
+//    File:		CalcSolve.h
+//
+//    Functions:	findRoot, integrate
+//----------------------------------------------------------------------------
+#ifndef CALCSOLVE_H
+#define CALCSOLVE_H
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		Root finder and integrator
+//
+//    Description:	Numeric routines over a function f(x) supplied by the
+//						caller as a functor: bool f(double x, double& fx),
+//						returning false if f cannot be evaluated at x.
+//						They are templates so the call to f is inlined
+//						into the iteration loop.
+//
+//						findRoot() is Brent's method: inverse quadratic
+//						interpolation or the secant step when it makes
+//						progress, bisection when it does not, so it
+//						converges as fast as the secant method on smooth
+//						functions and never slower than bisection.
+//
+//						integrate() is adaptive 7-15 point Gauss-Kronrod
+//						quadrature: the segment with the largest error
+//						estimate is halved until the total estimate is
+//						within tolerance.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  Functions:
+//		bool findRoot(F& f, double a, double b, double& root) -- a root of
+//			f in [a, b], where f(a) and f(b) differ in sign
+//		bool integrate(F& f, double a, double b, double& result,
+//			double& error) -- the integral of f from a to b
+//		bool integrated(double result, double error) -- error is within
+//			tolerance
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	const int SOLVE_ITERATIONS = 200;
+	const size_t INTEG_SEGMENTS = 200;
+	const double INTEG_RELTOL = 1e-10;
+	const double INTEG_ABSTOL = 1e-14;
+
+	//------------------------------------------------------------------------
+	//	Function:		findRoot(F& f, double a, double b, double& root)
+	//	Description:	Brent's method, to full double precision.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- false if f(a) and f(b) have the same sign,
+	//						f failed, or it did not converge
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	template <class F>
+	bool findRoot(F& f, double a, double b, double& root)
+	{
+		double fa, fb, fc;
+		double c, d, e;
+
+		if (!f(a, fa) || !f(b, fb))
+			return false;
+		if (fa == 0.0 || fb == 0.0)
+		{
+			root = (fa == 0.0) ? a : b;
+			return true;
+		}
+		if ((fa > 0.0) == (fb > 0.0))
+			return false;
+		c = a;
+		fc = fa;
+		d = e = b - a;
+		for (int iteration = 0; iteration < SOLVE_ITERATIONS; iteration++)
+		{
+			if ((fb > 0.0) == (fc > 0.0))		// keep the root in [b, c]
+			{
+				c = a;
+				fc = fa;
+				d = e = b - a;
+			}
+			if (std::fabs(fc) < std::fabs(fb))	// b is the best guess
+			{
+				a = b;
+				b = c;
+				c = a;
+				fa = fb;
+				fb = fc;
+				fc = fa;
+			}
+			double tol = 2.0 * DBL_EPSILON * std::fabs(b) + DBL_MIN;
+			double m = 0.5 * (c - b);
+			if (std::fabs(m) <= tol || fb == 0.0)
+			{
+				root = b;
+				return true;
+			}
+			if (std::fabs(e) < tol || std::fabs(fa) <= std::fabs(fb))
+				d = e = m;					// bisect
+			else
+			{
+				double s = fb / fa;
+				double p, q;
+				if (a == c)					// secant
+				{
+					p = 2.0 * m * s;
+					q = 1.0 - s;
+				}
+				else						// inverse quadratic
+				{
+					double r = fb / fc;
+					q = fa / fc;
+					p = s * (2.0 * m * q * (q - r) - (b - a) * (r - 1.0));
+					q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+				}
+				if (p > 0.0)
+					q = -q;
+				else
+					p = -p;
+				if (2.0 * p < std::min(3.0 * m * q - std::fabs(tol * q),
+					std::fabs(e * q)))
+				{
+					e = d;
+					d = p / q;
+				}
+				else
+					d = e = m;
+			}
+			a = b;
+			fa = fb;
+			b += (std::fabs(d) > tol) ? d : ((m > 0.0) ? tol : -tol);
+			if (!f(b, fb))
+				return false;
+		}
+		return false;
+	}
+
+	//------------------------------------------------------------------------
+	//	Function:		kronrod15(F& f, double a, double b, double& result,
+	//						double& error)
+	//	Description:	One 15-point Kronrod estimate over [a, b], with the
+	//						difference from the embedded 7-point Gauss rule
+	//						as its error.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- false if f failed
+	//	Called by:		integrate()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	template <class F>
+	bool kronrod15(F& f, double a, double b, double& result, double& error)
+	{
+		static const double nodes[8] = {
+			0.991455371120812639206854697526329,
+			0.949107912342758524526189684047851,
+			0.864864423359769072789712788640926,
+			0.741531185599394439863864773280788,
+			0.586087235467691130294144845693013,
+			0.405845151377397166906606412076961,
+			0.207784955007898467600689403773245,
+			0.0 };
+		static const double kronrod[8] = {
+			0.022935322010529224963732008058970,
+			0.063092092629978553290700663189204,
+			0.104790010322250183839876322541518,
+			0.140653259715525918745189590510238,
+			0.169004726639267902826583426598550,
+			0.190350578064785409913256402421014,
+			0.204432940075298892414161999234649,
+			0.209482141084727828012999174891714 };
+		static const double gauss[4] = {		// at the odd nodes
+			0.129484966168869693270611432679082,
+			0.279705391489276667901467771423780,
+			0.381830050505118944950369775488975,
+			0.417959183673469387755102040816327 };
+		double centre = 0.5 * (a + b);
+		double half = 0.5 * (b - a);
+		double fc, f1, f2;
+
+		if (!f(centre, fc))
+			return false;
+		double sumK = kronrod[7] * fc;
+		double sumG = gauss[3] * fc;
+		for (int j = 0; j < 7; j++)
+		{
+			double dx = half * nodes[j];
+			if (!f(centre - dx, f1) || !f(centre + dx, f2))
+				return false;
+			sumK += kronrod[j] * (f1 + f2);
+			if (j % 2 == 1)
+				sumG += gauss[j / 2] * (f1 + f2);
+		}
+		result = sumK * half;
+		error = std::fabs((sumK - sumG) * half);
+		return true;
+	}
+
+	// Tells whether an integral's error estimate is within tolerance.
+	inline bool integrated(double result, double error)
+	{
+		return error <= std::max(INTEG_ABSTOL, INTEG_RELTOL * std::fabs(result));
+	}
+
+	//------------------------------------------------------------------------
+	//	Function:		integrate(F& f, double a, double b, double& result,
+	//						double& error)
+	//	Description:	Adaptive Gauss-Kronrod over at most INTEG_SEGMENTS
+	//						segments.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- false if f failed; if the segments run
+	//						out first, result and error are the best
+	//						estimate, with error above integrated()'s
+	//						tolerance
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	template <class F>
+	bool integrate(F& f, double a, double b, double& result, double& error)
+	{
+		struct Segment
+		{
+			double a, b, result, error;
+		};
+		std::vector<Segment> segments;
+		Segment first = { a, b, 0.0, 0.0 };
+
+		segments.reserve(INTEG_SEGMENTS);
+		if (!kronrod15(f, a, b, first.result, first.error))
+			return false;
+		segments.push_back(first);
+		result = first.result;
+		error = first.error;
+		while (!integrated(result, error)
+			&& segments.size() < INTEG_SEGMENTS)
+		{
+			size_t worst = 0;
+			for (size_t i = 1; i < segments.size(); i++)
+				if (segments[i].error > segments[worst].error)
+					worst = i;
+			Segment left = segments[worst];
+			Segment right = left;
+			left.b = right.a = 0.5 * (left.a + left.b);
+			if (!kronrod15(f, left.a, left.b, left.result, left.error)
+				|| !kronrod15(f, right.a, right.b, right.result, right.error))
+				return false;
+			segments[worst] = left;
+			segments.push_back(right);
+			result = error = 0.0;
+			for (size_t i = 0; i < segments.size(); i++)
+			{
+				result += segments[i].result;
+				error += segments[i].error;
+			}
+		}
+		return true;
+	}
+} // end namespace TPUS_CALC
+
+#endif
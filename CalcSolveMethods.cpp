@@ -0,0 +1,179 @@
+#include "RPNCalc.h"
+#include "CalcSolve.h"
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			solve(cmd thecmd)
+	//	Description:	SOLVE and INTEG treat the program as f(x), with x in
+	//						register 0 and f(x) left on top of the stack.
+	//						"a b SOLVE" pushes a root of f in [a, b] (f(a)
+	//						and f(b) must differ in sign) and leaves it in
+	//						register 0; "a b INTEG" pushes the integral of
+	//						f from a to b and leaves register 0 as it was.
+	//						The program runs from its compiled code on a
+	//						scratch stack that keeps its capacity, so an
+	//						evaluation neither parses nor allocates.  The
+	//						evaluations together are one run for m_limits;
+	//						once a limit stops it every evaluation fails,
+	//						and the registers are put back as they were.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- SOLVE or INTEG
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			programSignature(); canEvaluate(); evaluate();
+	//						findRoot(); integrate(); snapshot(); restore();
+	//						CRunLimits::start(); CRunLimits::finish()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, enforcing
+	//									m_limits.
+	//------------------------------------------------------------------------
+	void CRPNCalc::solve(cmd thecmd)
+	{
+		double a = 0;
+		double b = 0;
+		double result = 0;
+		double error = 0;
+		double savedX = m_registers[0];
+		size_t lowWater = m_lowWater;
+		bool limited = false;
+		CSnapshot before;
+		bool found;
+
+		programSignature();
+		if (m_stack.size() < 2 || isBoxed(m_stack[0]) || isBoxed(m_stack[1])
+			|| !canEvaluate())
+		{
+			m_error = true;
+			return;
+		}
+		b = m_stack[0];
+		a = m_stack[1];
+		if (m_limits.active() && !m_limits.running())
+		{
+			limited = true;
+			before = snapshot();
+			lowWater = m_lowWater;
+			m_limits.start();
+		}
+		// f runs on m_scratch; the evaluations' stack changes are not the
+		//	user's, so they must not count toward m_lowWater either.
+		m_stack.swap(m_scratch);
+		auto f = [this](double x, double& fx) { return evaluate(x, fx); };
+		if (thecmd == SOLVE)
+			found = findRoot(f, a, b, result);
+		else
+			found = integrate(f, a, b, result, error);
+		m_stack.swap(m_scratch);
+		m_scratch.clear();
+		m_lowWater = lowWater;
+		// The evaluations' depths were checked as they ran.
+		if (limited && m_limits.finish(0))
+		{
+			restore(before);
+			m_error = true;
+			return;
+		}
+		m_registers[0] = (thecmd == SOLVE && found) ? result : savedX;
+		if (!found)
+		{
+			m_error = true;
+			return;
+		}
+		m_stack.pop_front(2);
+		stackTouched(m_stack.size());
+		m_stack.push_front(result);
+		// An integral that missed its tolerance is still pushed, as the
+		//	best estimate, but flagged.
+		if (thecmd == INTEG && !integrated(result, error))
+			m_error = true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			canEvaluate()
+	//	Description:	Tells whether the compiled program can serve as f(x):
+	//						it must not run, record or load programs, prompt,
+	//						undo, or solve or integrate in turn.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		bool -- true if solve() may run the program
+	//	Called by:		solve()
+	//	Calls:			promptsUser()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CRPNCalc::canEvaluate() const
+	{
+		const vector<Instr>& code = m_program.code();
+		if (code.empty())
+			return false;
+		for (size_t i = 0; i < code.size() && code[i].op != STOP; i++)
+		{
+			cmd op = static_cast<cmd>(code[i].op);
+			if (promptsUser(op) || op == RUN || op == EXIT || op == UNDO
+				|| op == REDO || op == SOLVE || op == INTEG || op == LOADN)
+				return false;
+		}
+		// x goes in R0, which must not be published to other sessions.
+		return m_shared[0] < 0;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			evaluate(double x, double& fx)
+	//	Description:	Runs the compiled program once with x in register 0,
+	//						on an empty stack.
+	//	Date:			10/19/2026
+	//	Version:		1.2
+	//	Programmers:	David Landry
+	//	Parameters:		double x -- the argument
+	//					double& fx -- receives the top of the stack
+	//	Returns:		bool -- false if a line failed or the program left
+	//						no number on top
+	//	Called by:		solve() (through findRoot() and integrate())
+	//	Calls:			canRunVerified(); runVerified(); execute();
+	//						CRunLimits::exceeded()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, running a
+	//									verified program with runVerified().
+	//					10/19/2026	DL completed version 1.2, failing once
+	//									a limit stops the run.
+	//------------------------------------------------------------------------
+	bool CRPNCalc::evaluate(double x, double& fx)
+	{
+		const vector<Instr>& code = m_program.code();
+		m_stack.clear();
+		m_registers[0] = x;
+		const StackSignature* signature = m_program.signature();
+		if (signature && canRunVerified(*signature))
+			m_error = runVerified(*signature) || m_error;
+		else
+			for (size_t i = 0; i < code.size() && code[i].op != STOP; i++)
+			{
+				if (m_limits.exceeded(m_stack.size()))
+				{
+					m_error = true;
+					break;
+				}
+				execute(code[i]);
+			}
+		if (m_error || m_stack.empty() || isBoxed(m_stack.front())
+			|| isnan(m_stack.front()))
+		{
+			m_error = false;
+			return false;
+		}
+		fx = m_stack.front();
+		return true;
+	}
+} // end namespace TPUS_CALC
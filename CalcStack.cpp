@@ -0,0 +1,116 @@
+//----------------------------------------------------------------------------
+//    Class:		CCalcStack
+//
+//    File:       CalcStack.cpp
+//
+//    Description: This file contains the function definitions for
+//					CCalcStack
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcStack.h"
+#include <cstring>
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	const size_t MIN_CAPACITY = 16;
+
+	//------------------------------------------------------------------------
+	//	Method:			CCalcStack()
+	//	Description:	Creates an empty stack.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CCalcStack::CCalcStack() : m_data(MIN_CAPACITY), m_head(0), m_size(0)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			assign(const double* first, const double* last)
+	//	Description:	Replaces the stack with the entries [first, last),
+	//						top first.
+	//	Programmers:	David Landry
+	//	Called by:		CRPNCalc::loadState()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CCalcStack::assign(const double* first, const double* last)
+	{
+		size_t count = last - first;
+		size_t capacity = MIN_CAPACITY;
+		while (capacity < count)
+			capacity *= 2;
+		vector<double>(capacity).swap(m_data);
+		m_size = count;
+		m_head = (capacity - count) & (capacity - 1);
+		if (count > 0)
+			memcpy(&m_data[capacity - count], first, count * sizeof(double));
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			reserve(size_t extra)
+	//	Description:	Makes room for extra more entries in one step, so a
+	//						bulk load does not regrow the ring as it goes.
+	//	Programmers:	David Landry
+	//	Called by:		CRPNCalc::importFile()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CCalcStack::reserve(size_t extra)
+	{
+		size_t capacity = m_data.size();
+		while (capacity < m_size + extra)
+			capacity *= 2;
+		if (capacity != m_data.size())
+			relayout(capacity);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			contiguous()
+	//	Description:	Gives the whole stack as one block, top first,
+	//						unwrapping the ring first if a rotation left it
+	//						split.
+	//	Programmers:	David Landry
+	//	Returns:		const double* -- the top entry; the rest follow it.
+	//						Valid until the stack is next changed.
+	//	Called by:		CRPNCalc::reduce(); CRPNCalc::saveState()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	const double* CCalcStack::contiguous()
+	{
+		if (m_head + m_size > m_data.size())
+			relayout(m_data.size());
+		return &m_data[m_head];
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			relayout(size_t capacity)
+	//	Description:	Moves the entries into a buffer of the given
+	//						capacity, unwrapped and against its end.
+	//	Programmers:	David Landry
+	//	Called by:		push_front(); push_back(); contiguous(); reserve()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL no indexing past the end when the
+	//									stack is empty
+	//------------------------------------------------------------------------
+	void CCalcStack::relayout(size_t capacity)
+	{
+		vector<double> data(capacity);
+		size_t start = capacity - m_size;
+		size_t firstPart = m_data.size() - m_head;
+		if (firstPart > m_size)
+			firstPart = m_size;
+		// start is capacity itself when the stack is empty.
+		memcpy(data.data() + start, m_data.data() + m_head,
+			firstPart * sizeof(double));
+		memcpy(data.data() + start + firstPart, m_data.data(),
+			(m_size - firstPart) * sizeof(double));
+		m_data.swap(data);
+		m_head = start & (capacity - 1);
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,123 @@
+//----------------------------------------------------------------------------
+//    File:		CalcStack.h
+//
+//    Class:	CCalcStack
+//----------------------------------------------------------------------------
+#ifndef CALCSTACK_H
+#define CALCSTACK_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		CCalcStack Class
+//
+//    Description:	The calculator stack.  It has the deque operations the
+//						calculator uses (both ends are O(1), so the U and
+//						D rotations stay cheap) but keeps its entries in
+//						one ring buffer instead of deque chunks.  Entry 0
+//						is the top.  The live entries sit against the end
+//						of the buffer, so pushes fill toward the front and
+//						the ring only wraps after a rotation; contiguous()
+//						undoes the wrap, which lets the reductions run
+//						straight over one block of memory.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  class CCalcStack:
+//
+//	  Properties:
+//		vector<double> m_data -- the ring; its size is a power of two
+//		size_t m_head -- index of the top entry in m_data
+//		size_t m_size -- number of entries
+//
+//	  Methods:
+//
+//		inline:
+//			size_t size() const
+//			bool empty() const
+//			double& front() / const double& front() const
+//			double& back() / const double& back() const
+//			double& operator[](size_t i) / const version
+//			void push_front(double value)
+//			void pop_front()
+//			void push_back(double value)
+//			void pop_back()
+//			void pop_front(size_t n)
+//			void clear()
+//			void swap(CCalcStack& other)
+//
+//		non-inline:
+//			CCalcStack();
+//			void assign(const double* first, const double* last);
+//			void reserve(size_t extra);
+//			const double* contiguous();
+//		private:
+//			void relayout(size_t capacity);
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	class CCalcStack
+	{
+	public:
+		CCalcStack();
+		size_t size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
+		double& front() { return m_data[m_head]; }
+		const double& front() const { return m_data[m_head]; }
+		double& back() { return (*this)[m_size - 1]; }
+		const double& back() const { return (*this)[m_size - 1]; }
+		double& operator[](size_t i)
+			{ return m_data[(m_head + i) & (m_data.size() - 1)]; }
+		const double& operator[](size_t i) const
+			{ return m_data[(m_head + i) & (m_data.size() - 1)]; }
+		void push_front(double value)
+		{
+			if (m_size == m_data.size())
+				relayout(m_data.size() * 2);
+			m_head = (m_head - 1) & (m_data.size() - 1);
+			m_data[m_head] = value;
+			m_size++;
+		}
+		void pop_front() { pop_front(1); }
+		void pop_front(size_t n)		// drops the top n entries
+		{
+			m_head = (m_head + n) & (m_data.size() - 1);
+			m_size -= n;
+		}
+		void push_back(double value)
+		{
+			if (m_size == m_data.size())
+				relayout(m_data.size() * 2);
+			m_size++;
+			back() = value;
+		}
+		void pop_back() { m_size--; }
+		void clear() { m_head = 0; m_size = 0; }
+		void swap(CCalcStack& other)
+		{
+			m_data.swap(other.m_data);
+			std::swap(m_head, other.m_head);
+			std::swap(m_size, other.m_size);
+		}
+		void assign(const double* first, const double* last);
+		void reserve(size_t extra);
+		const double* contiguous();
+
+	private:
+		void relayout(size_t capacity);
+
+		std::vector<double> m_data;
+		size_t m_head;
+		size_t m_size;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,482 @@
+#include "RPNCalc.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "CalcMappedFile.h"
+namespace TPUS_CALC
+{
+	// Layout of a state image: this header, then the stack (top first), the
+	//	registers, the named register values, the matrices, the complex
+	//	values, the sliding window's values (oldest first), the program text
+	//	and the register names ('\n'-terminated, in slot order).  Each
+	//	matrix is its handle's bits, its row and column counts (all uint64)
+	//	and its entries; each complex value is its handle's bits and its two
+	//	parts.  Everything up to the program starts on an 8-byte boundary.
+	//	Bump STATE_VERSION whenever the layout changes, and list any new
+	//	header fields in HEADER_FIELDS so older images still load.
+	const char STATE_MAGIC[8] = { 'R', 'P', 'N', 'S', 'T', 'A', 'T', 'E' };
+	const uint32_t STATE_VERSION = 5;
+	const uint32_t STATE_DEG = 1;		// flag bits
+	const uint32_t STATE_HELP = 2;
+	const uint32_t STATE_COMPLEX = 4;
+	// The display format rides in the flags too: its mode in bits 8 - 9
+	//	and its places in bits 16 - 23.  Older images have 0 there (STD).
+	const uint32_t STATE_FORMAT_SHIFT = 8;
+	const uint32_t STATE_DIGITS_SHIFT = 16;
+
+	struct StateHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t flags;
+		uint64_t stackCount;
+		uint64_t stackOffset;
+		uint64_t regCount;
+		uint64_t regOffset;
+		uint64_t namedCount;
+		uint64_t namedOffset;
+		uint64_t matrixCount;
+		uint64_t matrixBytes;
+		uint64_t matrixOffset;
+		uint64_t complexCount;
+		uint64_t complexOffset;
+		uint64_t windowCapacity;
+		uint64_t windowCount;
+		uint64_t windowOffset;
+		uint64_t programBytes;
+		uint64_t programOffset;
+		uint64_t namesBytes;
+		uint64_t namesOffset;
+		uint64_t totalSize;
+	};
+
+	// The header's fields after magic, version and flags, in file order,
+	//	with the version that added each.  An older image's header holds
+	//	only the fields its version had, in the same order; the rest are
+	//	left 0, so the sections they describe load empty.
+	struct HeaderField
+	{
+		uint64_t StateHeader::* field;
+		uint32_t since;
+	};
+	const HeaderField HEADER_FIELDS[] = {
+		{ &StateHeader::stackCount, 1 }, { &StateHeader::stackOffset, 1 },
+		{ &StateHeader::regCount, 1 }, { &StateHeader::regOffset, 1 },
+		{ &StateHeader::namedCount, 2 }, { &StateHeader::namedOffset, 2 },
+		{ &StateHeader::matrixCount, 3 }, { &StateHeader::matrixBytes, 3 },
+		{ &StateHeader::matrixOffset, 3 },
+		{ &StateHeader::complexCount, 4 }, { &StateHeader::complexOffset, 4 },
+		{ &StateHeader::windowCapacity, 5 }, { &StateHeader::windowCount, 5 },
+		{ &StateHeader::windowOffset, 5 },
+		{ &StateHeader::programBytes, 1 }, { &StateHeader::programOffset, 1 },
+		{ &StateHeader::namesBytes, 2 }, { &StateHeader::namesOffset, 2 },
+		{ &StateHeader::totalSize, 1 } };
+
+	// Reads the header of an image of any version up to STATE_VERSION.
+	static bool readHeader(const char* image, size_t imageSize,
+		StateHeader& header)
+	{
+		const size_t prefix = offsetof(StateHeader, stackCount);
+		header = StateHeader();
+		if (imageSize < prefix)
+			return false;
+		memcpy(&header, image, prefix);
+		if (memcmp(header.magic, STATE_MAGIC, sizeof(header.magic)) != 0
+			|| header.version < 1 || header.version > STATE_VERSION)
+			return false;
+		size_t at = prefix;
+		for (size_t i = 0; i < sizeof(HEADER_FIELDS) / sizeof(HEADER_FIELDS[0]);
+			i++)
+		{
+			if (HEADER_FIELDS[i].since > header.version)
+				continue;
+			if (imageSize - at < sizeof(uint64_t))
+				return false;
+			memcpy(&(header.*HEADER_FIELDS[i].field), image + at,
+				sizeof(uint64_t));
+			at += sizeof(uint64_t);
+		}
+		return true;
+	}
+
+	static uint64_t align8(uint64_t n)
+	{
+		return (n + 7) & ~static_cast<uint64_t>(7);
+	}
+
+	// Checks that count items of itemBytes bytes each fit between offset and
+	//	size.  The counts come from the file, so nothing is multiplied.
+	static bool fits(uint64_t offset, uint64_t count, uint64_t itemBytes,
+		uint64_t size)
+	{
+		return offset <= size && count <= (size - offset) / itemBytes;
+	}
+
+	// Checks that count matrix records fill exactly bytes bytes.
+	static bool validMatrices(const char* data, uint64_t count, uint64_t bytes)
+	{
+		uint64_t used = 0;
+		for (uint64_t i = 0; i < count; i++)
+		{
+			uint64_t record[3];
+			if (bytes - used < sizeof(record))
+				return false;
+			memcpy(record, data + used, sizeof(record));
+			used += sizeof(record);
+			if (record[1] == 0 || record[2] == 0
+				|| record[1] > (bytes - used) / sizeof(double) / record[2])
+				return false;
+			used += record[1] * record[2] * sizeof(double);
+		}
+		return used == bytes;
+	}
+
+	// Maps a saved matrix or complex handle to the handle it was loaded under.
+	static double rehandle(const unordered_map<uint64_t, double>& handles,
+		double value)
+	{
+		uint64_t bits;
+		if (!isBoxed(value))
+			return value;
+		memcpy(&bits, &value, sizeof(bits));
+		unordered_map<uint64_t, double>::const_iterator it = handles.find(bits);
+		return (it == handles.end()) ? NAN : it->second;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			saveState(const char* fileName)
+	//	Description:	Writes the whole calculator state (stack, registers,
+	//						named registers, matrices, complex values,
+	//						sliding window, program, trig and complex
+	//						modes, display format and help setting) to a
+	//						versioned binary image.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		const char* fileName -- the image file
+	//	Returns:		bool -- true if the image was written
+	//	Called by:		checkpoint(); a host process moving sessions
+	//	Calls:			ofstream::write()
+	//	Input:			None
+	//	Output:			The image file.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL version 2 image adds named registers
+	//					10/19/2026	DL version 3 image adds matrices
+	//					10/19/2026	DL version 4 image adds complex values
+	//					10/19/2026	DL saving the display format in the flags
+	//					10/19/2026	DL version 5 image adds the sliding window
+	//------------------------------------------------------------------------
+	bool CRPNCalc::saveState(const char* fileName)
+	{
+		StateHeader header = StateHeader();
+		const double* stackData;
+		string names;
+		vector<double> matrixData;
+		vector<double> complexData;
+		vector<double> windowData;
+		const char padding[8] = { 0 };
+		ofstream fileStream(fileName, ios::binary | ios::trunc);
+
+		if (!fileStream)
+			return false;
+		collectValues();		// save only the values still in use
+		for (uint32_t i = 0; i < m_matrices.slots(); i++)
+		{
+			double handle = box(BOX_MATRIX, i);
+			const CMatrix* matrix = m_matrices.get(handle);
+			if (!matrix)
+				continue;
+			uint64_t record[3] = { 0, matrix->rows, matrix->cols };
+			memcpy(&record[0], &handle, sizeof(handle));
+			size_t at = matrixData.size();
+			matrixData.resize(at + 3 + matrix->data.size());
+			memcpy(&matrixData[at], record, sizeof(record));
+			copy(matrix->data.begin(), matrix->data.end(),
+				matrixData.begin() + at + 3);
+			header.matrixCount++;
+		}
+		for (uint32_t i = 0; i < m_complexes.slots(); i++)
+		{
+			double handle = box(BOX_COMPLEX, i);
+			double parts[2];
+			if (!m_complexes.get(handle, parts[0], parts[1]))
+				continue;
+			complexData.push_back(handle);
+			complexData.push_back(parts[0]);
+			complexData.push_back(parts[1]);
+			header.complexCount++;
+		}
+		stackData = m_stack.contiguous();
+		memcpy(header.magic, STATE_MAGIC, sizeof(header.magic));
+		header.version = STATE_VERSION;
+		header.flags = ((m_trigmode == DEG) ? STATE_DEG : 0)
+			| (m_helpOn ? STATE_HELP : 0)
+			| (m_complex ? STATE_COMPLEX : 0)
+			| (static_cast<uint32_t>(m_format.mode()) << STATE_FORMAT_SHIFT)
+			| (static_cast<uint32_t>(m_format.digits()) << STATE_DIGITS_SHIFT);
+		header.stackCount = m_stack.size();
+		header.stackOffset = align8(sizeof(header));
+		header.regCount = NUMREGS;
+		header.regOffset = header.stackOffset
+			+ header.stackCount * sizeof(double);
+		header.namedCount = m_named.size();
+		header.namedOffset = header.regOffset
+			+ header.regCount * sizeof(double);
+		header.matrixBytes = matrixData.size() * sizeof(double);
+		header.matrixOffset = header.namedOffset
+			+ header.namedCount * sizeof(double);
+		header.programBytes = m_program.textSize();
+		header.complexOffset = header.matrixOffset + header.matrixBytes;
+		m_window.values(windowData);
+		header.windowCapacity = m_window.capacity();
+		header.windowCount = windowData.size();
+		header.windowOffset = header.complexOffset
+			+ complexData.size() * sizeof(double);
+		header.programOffset = header.windowOffset
+			+ windowData.size() * sizeof(double);
+		for (size_t slot = 0; slot < m_names.size(); slot++)
+			names += m_names.name(static_cast<int>(slot)) + '\n';
+		header.namesBytes = names.size();
+		header.namesOffset = header.programOffset + header.programBytes;
+		header.totalSize = align8(header.namesOffset + header.namesBytes);
+
+		fileStream.write(reinterpret_cast<const char*>(&header),
+			sizeof(header));
+		fileStream.write(padding, header.stackOffset - sizeof(header));
+		fileStream.write(reinterpret_cast<const char*>(stackData),
+			m_stack.size() * sizeof(double));
+		fileStream.write(reinterpret_cast<const char*>(m_registers),
+			NUMREGS * sizeof(double));
+		if (!m_named.empty())
+			fileStream.write(reinterpret_cast<const char*>(&m_named[0]),
+				m_named.size() * sizeof(double));
+		if (!matrixData.empty())
+			fileStream.write(reinterpret_cast<const char*>(&matrixData[0]),
+				header.matrixBytes);
+		if (!complexData.empty())
+			fileStream.write(reinterpret_cast<const char*>(&complexData[0]),
+				complexData.size() * sizeof(double));
+		if (!windowData.empty())
+			fileStream.write(reinterpret_cast<const char*>(&windowData[0]),
+				windowData.size() * sizeof(double));
+		fileStream.write(m_program.text(), m_program.textSize());
+		fileStream.write(names.data(), names.size());
+		fileStream.write(padding, header.totalSize
+			- (header.namesOffset + header.namesBytes));
+		return static_cast<bool>(fileStream);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			loadState(const char* fileName)
+	//	Description:	Replaces the calculator state with a saved image.
+	//						The file is memory-mapped and copied straight out
+	//						of the mapping, so warm-starting a session costs
+	//						one open, one map and a few block copies.  Older
+	//						images load too, with the sections they lack
+	//						empty.  A bad image leaves the state unchanged.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		const char* fileName -- the image file
+	//	Returns:		bool -- true if the state was restored
+	//	Called by:		resume(); a host process moving sessions
+	//	Calls:			CMappedFile; CProgram::assign(); stackTouched()
+	//	Input:			The image file.
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL version 2 image adds named registers;
+	//									older images are read through
+	//									readHeader()
+	//					10/19/2026	DL version 3 image adds matrices
+	//					10/19/2026	DL version 4 image adds complex values
+	//					10/19/2026	DL restoring the display format
+	//					10/19/2026	DL version 5 image adds the sliding window
+	//					10/19/2026	DL checking each section with fits(), so
+	//									a crafted count cannot overflow
+	//					10/19/2026	DL checking that the double arrays read
+	//									in place are 8-byte aligned
+	//					10/19/2026	DL reading the complex values at
+	//									complexOffset, where fits() checked them
+	//------------------------------------------------------------------------
+	bool CRPNCalc::loadState(const char* fileName)
+	{
+		CMappedFile file(fileName);
+		const char* image = file.data();
+		size_t imageSize = file.size();
+		bool loaded = false;
+		if (!file.isOpen())
+			return false;
+		StateHeader header;
+		if (readHeader(image, imageSize, header))
+		{
+			loaded = header.regCount == NUMREGS
+				&& header.totalSize <= imageSize
+				&& header.stackOffset % 8 == 0 && header.namedOffset % 8 == 0
+				&& header.windowOffset % 8 == 0
+				&& fits(header.stackOffset, header.stackCount,
+					sizeof(double), header.totalSize)
+				&& fits(header.regOffset, header.regCount,
+					sizeof(double), header.totalSize)
+				&& fits(header.namedOffset, header.namedCount,
+					sizeof(double), header.totalSize)
+				&& fits(header.matrixOffset, header.matrixBytes, 1,
+					header.totalSize)
+				&& fits(header.complexOffset, header.complexCount,
+					3 * sizeof(double), header.totalSize)
+				&& header.windowCapacity <= WINDOW_MAX
+				&& header.windowCount <= header.windowCapacity
+				&& fits(header.windowOffset, header.windowCount,
+					sizeof(double), header.totalSize)
+				&& fits(header.programOffset, header.programBytes, 1,
+					header.totalSize)
+				&& fits(header.namesOffset, header.namesBytes, 1,
+					header.totalSize)
+				&& validMatrices(image + header.matrixOffset,
+					header.matrixCount, header.matrixBytes);
+		}
+		if (loaded)
+		{
+			const double* stackData = reinterpret_cast<const double*>(
+				image + header.stackOffset);
+			m_stack.assign(stackData, stackData + header.stackCount);
+			stackTouched(0);
+			memcpy(m_registers, image + header.regOffset,
+				NUMREGS * sizeof(double));
+			m_program.assign(image + header.programOffset,
+				static_cast<size_t>(header.programBytes));
+			// Names keep the slots they already have here (compiled code
+			//	may refer to them); the image's names are matched by name.
+			const double* namedData = reinterpret_cast<const double*>(
+				image + header.namedOffset);
+			const char* name = image + header.namesOffset;
+			const char* namesEnd = name + header.namesBytes;
+			fill(m_named.begin(), m_named.end(), 0.0);
+			for (uint64_t i = 0; i < header.namedCount && name < namesEnd; i++)
+			{
+				const char* newline = static_cast<const char*>(
+					memchr(name, '\n', namesEnd - name));
+				if (!newline)
+					break;
+				int slot = m_names.intern(name, newline - name);
+				if (m_named.size() < m_names.size())
+					m_named.resize(m_names.size(), 0.0);
+				m_named[slot] = namedData[i];
+				name = newline + 1;
+			}
+			// The image's matrices and complex values get new handles
+			//	here; rewrite every saved handle to match (or to a plain NaN
+			//	if it is stale).
+			unordered_map<uint64_t, double> handles;
+			const char* record = image + header.matrixOffset;
+			for (uint64_t i = 0; i < header.matrixCount; i++)
+			{
+				uint64_t fields[3];
+				memcpy(fields, record, sizeof(fields));
+				CMatrix matrix(static_cast<size_t>(fields[1]),
+					static_cast<size_t>(fields[2]));
+				memcpy(&matrix.data[0], record + sizeof(fields),
+					matrix.data.size() * sizeof(double));
+				record += sizeof(fields) + matrix.data.size() * sizeof(double);
+				handles[fields[0]] = m_matrices.add(matrix);
+			}
+			record = image + header.complexOffset;
+			for (uint64_t i = 0; i < header.complexCount; i++)
+			{
+				uint64_t bits;
+				double parts[2];
+				memcpy(&bits, record, sizeof(bits));
+				memcpy(parts, record + sizeof(bits), sizeof(parts));
+				record += sizeof(bits) + sizeof(parts);
+				handles[bits] = m_complexes.add(parts[0], parts[1]);
+			}
+			for (size_t i = 0; i < m_stack.size(); i++)
+				m_stack[i] = rehandle(handles, m_stack[i]);
+			for (size_t i = 0; i < NUMREGS; i++)
+				m_registers[i] = rehandle(handles, m_registers[i]);
+			for (size_t i = 0; i < m_named.size(); i++)
+				m_named[i] = rehandle(handles, m_named[i]);
+			m_profile.clear();
+			m_trigmode = (header.flags & STATE_DEG) ? DEG : RAD;
+			m_helpOn = (header.flags & STATE_HELP) != 0;
+			m_complex = (header.flags & STATE_COMPLEX) != 0;
+			const double* windowData = reinterpret_cast<const double*>(
+				image + header.windowOffset);
+			m_window.resize(static_cast<size_t>(header.windowCapacity));
+			for (uint64_t i = 0; i < header.windowCount; i++)
+				if (!isnan(windowData[i]))
+					m_window.push(windowData[i]);
+			if (!m_format.set(static_cast<FormatMode>(
+				(header.flags >> STATE_FORMAT_SHIFT) & 3),
+				static_cast<int>((header.flags >> STATE_DIGITS_SHIFT) & 0xff)))
+				m_format.set(FMT_STD, 0);
+		}
+		return loaded;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			checkpoint()
+	//	Description:	Asks the user for a filename and saves the whole
+	//						calculator state to it
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			saveState()
+	//	Input:			The file name.
+	//	Output:			Prompts for the file name and error messages, if
+	//						applicable.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::checkpoint()
+	{
+		char fileName[BUFFER_SIZE];
+		cout << "Please enter a file name to save the calculator state to."
+			<< endl;
+		cout << "(The file will be automatically saved as a .rpns file.)  ";
+		(cin >> fileName).get();
+		strcat(fileName, ".rpns");
+		if (saveState(fileName))
+			cout << "Done.  Press \"Enter\" to continue.";
+		else
+			cout << "Could not write the file.  Press \"Enter\" to continue.";
+		cin.get();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			resume()
+	//	Description:	Asks the user for a filename and restores the whole
+	//						calculator state from it
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			loadState()
+	//	Input:			The file name.
+	//	Output:			Prompts for the file name and error messages, if
+	//						applicable.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::resume()
+	{
+		char fileName[BUFFER_SIZE];
+		cout << "Please enter a file name to restore the calculator state"
+			" from." << endl;
+		cout << "(The .rpns extention will automatically be appended)  ";
+		(cin >> fileName).get();
+		strcat(fileName, ".rpns");
+		if (loadState(fileName))
+			cout << "Done.  Press \"Enter\" to continue.";
+		else
+			cout << "Could not read a calculator state from the file."
+				"  Press \"Enter\" to continue.";
+		cin.get();
+	}
+}
@@ -0,0 +1,119 @@
+//----------------------------------------------------------------------------
+//    Class:		CTermView
+//
+//    File:       CalcTermView.cpp
+//
+//    Description: This file contains the function definitions for CTermView
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcTermView.h"
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CTermView()
+	//	Description:	Nothing is on screen yet, so the first render paints
+	//						everything.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CTermView::CTermView() : m_valid(false), m_ansi(-1)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			isTerminal(const ostream& ostr)
+	//	Description:	Tells whether ostr is cout attached to a terminal that
+	//						understands ANSI escapes.  Checked once; on
+	//						Windows this also turns on VT processing.
+	//	Programmers:	David Landry
+	//	Parameters:		const ostream& ostr -- the stream being printed to
+	//	Returns:		bool -- true if incremental rendering can be used
+	//	Called by:		CRPNCalc::print()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CTermView::isTerminal(const ostream& ostr)
+	{
+		if (&ostr != &cout)
+			return false;
+		if (m_ansi < 0)
+		{
+#ifdef _WIN32
+			HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+			DWORD mode = 0;
+			m_ansi = _isatty(_fileno(stdout)) && GetConsoleMode(console, &mode)
+				&& SetConsoleMode(console,
+					mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#else
+			m_ansi = isatty(STDOUT_FILENO) ? 1 : 0;
+#endif
+		}
+		return m_ansi == 1;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			render(ostream& ostr, const vector<string>& rows)
+	//	Description:	Brings the screen up to date with rows (row 0 at the
+	//						top) and leaves the cursor on a cleared line just
+	//						below them, ready for input.
+	//	Programmers:	David Landry
+	//	Parameters:		ostream& ostr -- the terminal
+	//					const vector<string>& rows -- the screen contents
+	//	Called by:		CRPNCalc::print()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CTermView::render(ostream& ostr, const vector<string>& rows)
+	{
+		size_t inputRow = rows.size() + 1;	// 1-based terminal row
+		string out;
+#ifndef _WIN32
+		// Typing Enter on the last terminal line scrolls the screen, after
+		//	which the rows are no longer where m_shown says they are.
+		struct winsize size;
+		if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0
+			&& size.ws_row > 0 && size.ws_row <= inputRow)
+			m_valid = false;
+#endif
+		if (!m_valid || m_shown.size() != rows.size())
+		{
+			out = "\x1b[2J\x1b[H";
+			for (size_t i = 0; i < rows.size(); i++)
+			{
+				out += rows[i];
+				out += "\n";
+			}
+			m_shown = rows;
+			m_valid = true;
+		}
+		else
+		{
+			for (size_t i = 0; i < rows.size(); i++)
+			{
+				if (rows[i] != m_shown[i])
+				{
+					out += "\x1b[" + to_string(i + 1) + ";1H";
+					out += rows[i];
+					out += "\x1b[K";
+					m_shown[i] = rows[i];
+				}
+			}
+		}
+		out += "\x1b[" + to_string(inputRow) + ";1H\x1b[J";
+		ostr << out << flush;
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,66 @@
+//----------------------------------------------------------------------------
+//    File:		CalcTermView.h
+//
+//    Class:	CTermView
+//----------------------------------------------------------------------------
+#ifndef CALCTERMVIEW_H
+#define CALCTERMVIEW_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		CTermView Class
+//
+//    Description:	Incremental terminal renderer.  The calculator screen
+//						is a list of rows; the view remembers what each row
+//						last showed and, using ANSI escape sequences, moves
+//						the cursor to and rewrites only the rows that
+//						changed.  The whole screen is repainted only the
+//						first time, after invalidate(), or when the
+//						terminal is too short to hold the layout.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  class CTermView:
+//
+//	  Properties:
+//		vector<string> m_shown -- what each row currently shows
+//		bool m_valid -- m_shown matches the screen
+//		int m_ansi -- -1 not yet checked, 0 plain output, 1 ANSI terminal
+//
+//	  Methods:
+//
+//		inline:
+//			void invalidate()
+//
+//		non-inline:
+//			CTermView();
+//			bool isTerminal(const ostream& ostr);
+//			void render(ostream& ostr, const vector<string>& rows);
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	class CTermView
+	{
+	public:
+		CTermView();
+		bool isTerminal(const std::ostream& ostr);
+		void render(std::ostream& ostr, const std::vector<std::string>& rows);
+		void invalidate() { m_valid = false; }
+
+	private:
+		std::vector<std::string> m_shown;
+		bool m_valid;
+		int m_ansi;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,161 @@
+//----------------------------------------------------------------------------
+//    Class:		CTraceBuffer
+//
+//    File:       CalcTrace.cpp
+//
+//    Description: This file contains the function definitions for
+//					CTraceBuffer
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcTrace.h"
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CTraceBuffer()
+	//	Description:	Allocates the ring once; tracing starts disabled.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CTraceBuffer::CTraceBuffer() : m_slots(CAPACITY), m_head(0),
+		m_enabled(false)
+	{
+		for (unsigned i = 0; i < CAPACITY; i++)
+			m_slots[i].seq.store(0, memory_order_relaxed);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			enable(bool on)
+	//	Description:	Turns recording on or off.  Turning it on starts a
+	//						fresh trace.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CTraceBuffer::enable(bool on)
+	{
+		if (on && !enabled())
+			clear();
+		m_enabled.store(on, memory_order_relaxed);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			clear()
+	//	Description:	Forgets every recorded event.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CTraceBuffer::clear()
+	{
+		for (unsigned i = 0; i < CAPACITY; i++)
+			m_slots[i].seq.store(0, memory_order_relaxed);
+		m_head.store(0, memory_order_release);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			record(const TraceEvent& e)
+	//	Description:	Appends an event, overwriting the oldest one once the
+	//						ring is full.  Single producer; never blocks.
+	//	Programmers:	David Landry
+	//	Parameters:		const TraceEvent& e -- the event to store
+	//	Called by:		CRPNCalc::runProgram()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CTraceBuffer::record(const TraceEvent& e)
+	{
+		unsigned long long i = m_head.load(memory_order_relaxed);
+		Slot& slot = m_slots[i & (CAPACITY - 1)];
+		// A zero sequence tells readers the slot is mid-write.
+		slot.seq.store(0, memory_order_relaxed);
+		atomic_thread_fence(memory_order_release);
+		slot.event = e;
+		slot.seq.store(i + 1, memory_order_release);
+		m_head.store(i + 1, memory_order_release);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			collect(vector<TraceEvent>& out)
+	//	Description:	Copies the events still in the ring, oldest first.
+	//						Slots overwritten while being copied are skipped.
+	//	Programmers:	David Landry
+	//	Parameters:		vector<TraceEvent>& out -- receives the events
+	//	Returns:		the number of events copied
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	size_t CTraceBuffer::collect(vector<TraceEvent>& out) const
+	{
+		unsigned long long head = m_head.load(memory_order_acquire);
+		unsigned long long first = (head > CAPACITY) ? head - CAPACITY : 0;
+		out.clear();
+		out.reserve(static_cast<size_t>(head - first));
+		for (unsigned long long i = first; i < head; i++)
+		{
+			const Slot& slot = m_slots[i & (CAPACITY - 1)];
+			if (slot.seq.load(memory_order_acquire) != i + 1)
+				continue;
+			TraceEvent e = slot.event;
+			atomic_thread_fence(memory_order_acquire);
+			if (slot.seq.load(memory_order_relaxed) == i + 1)
+				out.push_back(e);
+		}
+		return out.size();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			exportChrome(ostream& ostr, opNames)
+	//	Description:	Writes the buffer as Chrome trace_event JSON (one
+	//						complete "X" event per program line) that
+	//						chrome://tracing and Perfetto can open.
+	//	Programmers:	David Landry
+	//	Parameters:		ostream& ostr -- where the JSON goes
+	//					const vector<string>& opNames -- display name for
+	//						each cmd value
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CTraceBuffer::exportChrome(ostream& ostr,
+		const vector<string>& opNames) const
+	{
+		vector<TraceEvent> events;
+		collect(events);
+		long long origin = events.empty() ? 0 : events.front().ts;
+		streamsize oldPrecision = ostr.precision(15);
+
+		ostr << "{\"traceEvents\":[";
+		for (size_t i = 0; i < events.size(); i++)
+		{
+			const TraceEvent& e = events[i];
+			string name = (e.op >= 0 && e.op < (int)opNames.size()
+				&& !opNames[e.op].empty()) ? opNames[e.op] : "?";
+			if (i > 0)
+				ostr << ',';
+			ostr << "\n{\"name\":\"";
+			// Escape the characters JSON cares about in command names.
+			for (size_t c = 0; c < name.size(); c++)
+			{
+				if (name[c] == '"' || name[c] == '\\')
+					ostr << '\\';
+				ostr << name[c];
+			}
+			ostr << "\",\"cat\":\"rpn\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+				<< ",\"ts\":" << (e.ts - origin) / 1000.0
+				<< ",\"dur\":" << e.dur / 1000.0
+				<< ",\"args\":{\"line\":" << e.line
+				<< ",\"depth\":" << e.depth
+				<< ",\"top\":";
+			if (e.top == e.top && e.top - e.top == 0)	// finite
+				ostr << e.top;
+			else
+				ostr << "\"" << e.top << "\"";
+			ostr << "}}";
+		}
+		ostr << "\n],\"displayTimeUnit\":\"ns\"}\n";
+		ostr.precision(oldPrecision);
+	}
+} // end namespace TPUS_CALC
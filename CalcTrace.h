@@ -0,0 +1,139 @@
+//----------------------------------------------------------------------------
+//    File:		CalcTrace.h
+//
+//    Class:	CTraceBuffer
+//----------------------------------------------------------------------------
+#ifndef CALCTRACE_H
+#define CALCTRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+//----------------------------------------------------------------------------
+//
+//    Title:		CTraceBuffer Class
+//
+//    Description:	Fixed-size ring buffer of program execution events.
+//						One thread (the calculator) records; any thread may
+//						read a copy of the buffer without taking a lock.
+//						When tracing is off the only cost is one relaxed
+//						load of m_enabled per program line.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  struct TraceEvent:
+//		int op -- cmd enum value of the executed line
+//		int line -- program line index
+//		unsigned depth -- stack depth after the line ran
+//		double top -- top of stack after the line ran (0 if empty)
+//		long long ts -- start time in ns (steady clock)
+//		long long dur -- duration in ns
+//
+//	  struct ProfileEntry:
+//		unsigned long long count -- times the program line ran
+//		unsigned long long cycles -- cycle counter ticks spent in the line
+//
+//	  inline unsigned long long cycleCount() -- time stamp counter, or the
+//		steady clock in ns where there is none
+//
+//	  class CTraceBuffer:
+//
+//	  Properties:
+//		vector<Slot> m_slots -- CAPACITY event slots, each with a sequence
+//		atomic<unsigned long long> m_head -- count of events ever recorded
+//		atomic<bool> m_enabled -- tracing on/off
+//
+//	  Methods:
+//
+//		inline:
+//			bool enabled() const
+//			static long long now()
+//
+//		non-inline:
+//			CTraceBuffer();
+//			void enable(bool on);
+//			void clear();
+//			void record(const TraceEvent& e);
+//			size_t collect(vector<TraceEvent>& out) const;
+//			void exportChrome(ostream& ostr,
+//				const vector<string>& opNames) const;
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+//			10/19/26 DL added ProfileEntry and cycleCount() for PROF
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	struct TraceEvent
+	{
+		int op;
+		int line;
+		unsigned depth;
+		double top;
+		long long ts;
+		long long dur;
+	};
+
+	struct ProfileEntry
+	{
+		unsigned long long count;
+		unsigned long long cycles;
+	};
+
+	inline unsigned long long cycleCount()
+	{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+
+	class CTraceBuffer
+	{
+	public:
+		static const unsigned CAPACITY = 1 << 16;	// must be a power of 2
+
+		CTraceBuffer();
+		bool enabled() const
+			{ return m_enabled.load(std::memory_order_relaxed); }
+		void enable(bool on);
+		void clear();
+		void record(const TraceEvent& e);
+		size_t collect(std::vector<TraceEvent>& out) const;
+		void exportChrome(std::ostream& ostr,
+			const std::vector<std::string>& opNames) const;
+
+		static long long now()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+	private:
+		// seq holds (event index + 1) once the slot's event is complete,
+		//	so a reader can tell a finished slot from one being overwritten.
+		struct Slot
+		{
+			std::atomic<unsigned long long> seq;
+			TraceEvent event;
+		};
+
+		std::vector<Slot> m_slots;
+		std::atomic<unsigned long long> m_head;
+		std::atomic<bool> m_enabled;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,133 @@
+//----------------------------------------------------------------------------
+//    Class:		CPersistentStack
+//
+//    File:       CalcUndo.cpp
+//
+//    Description: This file contains the function definitions for
+//					CPersistentStack
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcUndo.h"
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CPersistentStack()
+	//	Description:	Creates an empty stack image.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CPersistentStack::CPersistentStack() : m_head(0), m_size(0)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			CPersistentStack(const CPersistentStack& other)
+	//	Description:	O(1) copy; both images share every node.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CPersistentStack::CPersistentStack(const CPersistentStack& other)
+		: m_head(other.m_head), m_size(other.m_size)
+	{
+		if (m_head)
+			m_head->refs++;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			operator=(const CPersistentStack& other)
+	//	Description:	O(1) assignment; releases this image's old nodes.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CPersistentStack& CPersistentStack::operator=(
+		const CPersistentStack& other)
+	{
+		if (other.m_head)
+			other.m_head->refs++;
+		release(m_head);
+		m_head = other.m_head;
+		m_size = other.m_size;
+		return *this;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			~CPersistentStack()
+	//	Description:	Releases the nodes no other image still uses.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CPersistentStack::~CPersistentStack()
+	{
+		release(m_head);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			push(double value)
+	//	Description:	Puts a new entry on top.  The entries below are
+	//						shared, not copied.
+	//	Programmers:	David Landry
+	//	Parameters:		double value -- the new top of stack
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CPersistentStack::push(double value)
+	{
+		PNode* node = new PNode;
+		node->value = value;
+		node->next = m_head;	// takes over this image's reference
+		node->refs = 1;
+		m_head = node;
+		m_size++;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			tail(size_t n)
+	//	Description:	The image with the top n entries removed.  It shares
+	//						all of its nodes with this one.
+	//	Programmers:	David Landry
+	//	Parameters:		size_t n -- entries to drop (at most size())
+	//	Returns:		CPersistentStack -- the remaining image
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CPersistentStack CPersistentStack::tail(size_t n) const
+	{
+		CPersistentStack result;
+		PNode* node = m_head;
+		if (n > m_size)
+			n = m_size;
+		for (size_t i = 0; i < n; i++)
+			node = node->next;
+		if (node)
+			node->refs++;
+		result.m_head = node;
+		result.m_size = m_size - n;
+		return result;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			release(PNode* node)
+	//	Description:	Drops one reference to node, freeing it and any nodes
+	//						below it that become unused.  Iterative, so very
+	//						deep stacks do not exhaust the call stack.
+	//	Programmers:	David Landry
+	//	Parameters:		PNode* node -- may be null
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CPersistentStack::release(PNode* node)
+	{
+		while (node && --node->refs == 0)
+		{
+			PNode* next = node->next;
+			delete node;
+			node = next;
+		}
+	}
+} // end namespace TPUS_CALC
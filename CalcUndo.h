@@ -0,0 +1,103 @@
+//----------------------------------------------------------------------------
+//    File:		CalcUndo.h
+//
+//    Class:	CPersistentStack
+//----------------------------------------------------------------------------
+#ifndef CALCUNDO_H
+#define CALCUNDO_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		CPersistentStack Class
+//
+//    Description:	An immutable, structurally shared stack of doubles (a
+//						reference-counted cons list, top first).  Copying one
+//						is O(1), and a new image built on top of an older
+//						one's tail shares every node below the change, so a
+//						history of undo points costs memory only for what
+//						actually changed between them.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  struct PNode:
+//		double value -- the stack entry
+//		PNode* next -- the entry below it
+//		unsigned refs -- images and nodes that point at this node
+//
+//	  class CPersistentStack:
+//
+//	  Properties:
+//		PNode* m_head -- top of the stack (null if empty)
+//		size_t m_size -- number of entries
+//
+//	  Methods:
+//
+//		inline:
+//			size_t size() const
+//			const PNode* head() const
+//			bool sameAs(const CPersistentStack& other) const
+//
+//		non-inline:
+//			CPersistentStack();
+//			CPersistentStack(const CPersistentStack& other);
+//			CPersistentStack& operator=(const CPersistentStack& other);
+//			~CPersistentStack();
+//			void push(double value);
+//			CPersistentStack tail(size_t n) const;
+//
+//	  struct CSnapshot:
+//		CPersistentStack stack -- the calculator stack
+//		shared_ptr<const vector<double> > registers -- register values,
+//			shared with the previous snapshot when unchanged
+//		shared_ptr<const vector<double> > named -- named register values,
+//			shared the same way
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	struct PNode
+	{
+		double value;
+		PNode* next;
+		unsigned refs;
+	};
+
+	class CPersistentStack
+	{
+	public:
+		CPersistentStack();
+		CPersistentStack(const CPersistentStack& other);
+		CPersistentStack& operator=(const CPersistentStack& other);
+		~CPersistentStack();
+		void push(double value);
+		CPersistentStack tail(size_t n) const;
+
+		size_t size() const { return m_size; }
+		const PNode* head() const { return m_head; }
+		bool sameAs(const CPersistentStack& other) const
+			{ return m_head == other.m_head && m_size == other.m_size; }
+
+	private:
+		static void release(PNode* node);
+
+		PNode* m_head;
+		size_t m_size;
+	};
+
+	struct CSnapshot
+	{
+		CPersistentStack stack;
+		std::shared_ptr<const std::vector<double> > registers;
+		std::shared_ptr<const std::vector<double> > named;
+	};
+} // end namespace TPUS_CALC
+
+#endif
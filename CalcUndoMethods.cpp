@@ -0,0 +1,229 @@
+#include "RPNCalc.h"
+namespace TPUS_CALC
+{
+	// Named registers only ever grow, and a new one starts at 0, so two
+	//	value lists are the same if they agree and any extra entries are 0.
+	static bool sameNamed(const vector<double>& a, const vector<double>& b)
+	{
+		size_t common = min(a.size(), b.size());
+		const vector<double>& longer = (a.size() > b.size()) ? a : b;
+		return equal(a.begin(), a.begin() + common, b.begin())
+			&& count(longer.begin() + common, longer.end(), 0.0)
+				== static_cast<ptrdiff_t>(longer.size() - common);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			snapshot()
+	//	Description:	Captures the stack and registers (numbered and
+	//						named) as a persistent image.  Only the entries
+	//						above m_lowWater can differ from m_image, so only
+	//						those get new nodes; everything below is shared
+	//						with m_image.  For the usual one-command change
+	//						the stack part is O(1).
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		CSnapshot -- the current state
+	//	Called by:		input(); undo(); redo(); saveSnapshot()
+	//	Calls:			CPersistentStack::tail(); CPersistentStack::push()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CSnapshot CRPNCalc::snapshot()
+	{
+		CSnapshot image;
+		size_t depth = m_stack.size();
+		size_t keep = min(m_lowWater, depth);
+
+		image.stack = m_image.stack.tail(m_image.stack.size() - keep);
+		for (size_t i = depth - keep; i-- > 0; )
+			image.stack.push(m_stack[i]);
+		if (equal(m_registers, m_registers + NUMREGS,
+			m_image.registers->begin()))
+			image.registers = m_image.registers;
+		else
+			image.registers.reset(
+				new vector<double>(m_registers, m_registers + NUMREGS));
+		if (sameNamed(m_named, *m_image.named))
+			image.named = m_image.named;
+		else
+			image.named.reset(new vector<double>(m_named));
+		m_image = image;
+		m_lowWater = depth;
+		return image;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			restore(const CSnapshot& image)
+	//	Description:	Replaces the stack and registers with a snapshot.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		const CSnapshot& image -- the state to go back to
+	//	Returns:		None
+	//	Called by:		undo(); redo(); recallSnapshot()
+	//	Calls:			None
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::restore(const CSnapshot& image)
+	{
+		m_stack.clear();
+		for (const PNode* node = image.stack.head(); node; node = node->next)
+			m_stack.push_back(node->value);
+		copy(image.registers->begin(), image.registers->end(), m_registers);
+		// Names made since the image keep their slots but go back to 0.
+		m_named.assign(image.named->begin(), image.named->end());
+		if (m_named.size() < m_names.size())
+			m_named.resize(m_names.size(), 0.0);
+		m_image = image;
+		m_lowWater = m_stack.size();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			stateChanged(const CSnapshot& before)
+	//	Description:	Tells whether anything changed since before was
+	//						taken, without building a new image.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		const CSnapshot& before -- the state to compare to
+	//	Returns:		bool -- true if the stack or a register changed
+	//	Called by:		input()
+	//	Calls:			None
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CRPNCalc::stateChanged(const CSnapshot& before) const
+	{
+		return !m_image.stack.sameAs(before.stack)
+			|| m_lowWater < before.stack.size()
+			|| m_stack.size() != before.stack.size()
+			|| !equal(m_registers, m_registers + NUMREGS,
+				before.registers->begin())
+			|| !sameNamed(m_named, *before.named);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			undo()
+	//	Description:	Goes back to the state before the last input line
+	//						that changed the stack or registers.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			snapshot(); restore()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::undo()
+	{
+		if (m_undo.empty())
+			m_error = true;
+		else
+		{
+			m_redo.push_back(snapshot());
+			restore(m_undo.back());
+			m_undo.pop_back();
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			redo()
+	//	Description:	Reapplies the state most recently undone.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			snapshot(); restore()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::redo()
+	{
+		if (m_redo.empty())
+			m_error = true;
+		else
+		{
+			m_undo.push_back(snapshot());
+			restore(m_redo.back());
+			m_redo.pop_back();
+		}
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			saveSnapshot()
+	//	Description:	Asks the user for a name and keeps the current stack
+	//						and registers under it, replacing any snapshot
+	//						with the same name.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			snapshot()
+	//	Input:			The snapshot name.
+	//	Output:			A prompt for the name.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::saveSnapshot()
+	{
+		string name;
+		cout << "Please enter a name for the snapshot.  ";
+		getline(cin, name);
+		if (name.empty())
+			m_error = true;
+		else
+			m_snapshots[name] = snapshot();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			recallSnapshot()
+	//	Description:	Asks the user for a snapshot name and restores the
+	//						stack and registers saved under it.  The recall
+	//						itself can be undone.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			restore()
+	//	Input:			The snapshot name.
+	//	Output:			A prompt for the name and the saved names.
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::recallSnapshot()
+	{
+		string name;
+		map<string, CSnapshot>::iterator it;
+		cout << "Snapshots:";
+		for (it = m_snapshots.begin(); it != m_snapshots.end(); it++)
+			cout << "  " << it->first;
+		cout << endl << "Please enter the name of the snapshot to restore.  ";
+		getline(cin, name);
+		it = m_snapshots.find(name);
+		if (it == m_snapshots.end())
+			m_error = true;
+		else
+			restore(it->second);
+	}
+}
@@ -0,0 +1,343 @@
+#include "RPNCalc.h"
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			verifyProgram()
+	//	Description:	Works out the stack effect of the compiled program
+	//						without running it.  Programs have no jumps, so
+	//						one pass over the code follows every path: each
+	//						instruction needs some entries and leaves some,
+	//						and the depth relative to entry is tracked
+	//						through to STOP.  Only instructions whose effect
+	//						is fixed are allowed (numbers, registers,
+	//						arithmetic, the one-argument functions, CE, D
+	//						and U); a program with anything else is left
+	//						unverified and always runs checked.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		StackSignature -- what the program needs and leaves
+	//	Called by:		programSignature()
+	//	Calls:			None
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	StackSignature CRPNCalc::verifyProgram() const
+	{
+		StackSignature signature = { false, 0, 0, 0, false, 0, false };
+		const vector<Instr>& code = m_program.code();
+		long depth = 0;			// relative to the entry depth
+		long lowest = 0;
+		long highest = 0;
+
+		for (size_t i = 0; i < code.size() && code[i].op != STOP; i++)
+		{
+			cmd op = static_cast<cmd>(code[i].op);
+			long needs;				// entries the instruction reads
+			long pops;				// entries it removes
+			long pushes;			// entries it adds
+			switch (op)
+			{
+			case NOP:
+				needs = pops = pushes = 0;
+				break;
+			case PUSH:
+				needs = pops = 0;
+				pushes = 1;
+				break;
+			case GETN:
+				signature.readsNamed = true;
+				needs = pops = 0;
+				pushes = 1;
+				break;
+			case GR0: case GR1: case GR2: case GR3: case GR4:
+			case GR5: case GR6: case GR7: case GR8: case GR9:
+				signature.registersRead |= 1u << (op - GR0);
+				needs = pops = 0;
+				pushes = 1;
+				break;
+			case SETN:
+			case SR0: case SR1: case SR2: case SR3: case SR4:
+			case SR5: case SR6: case SR7: case SR8: case SR9:
+				needs = 1;
+				pops = pushes = 0;
+				break;
+			case ADD: case SUB: case MULT: case DIV: case EXP: case MOD:
+				needs = pops = 2;
+				pushes = 1;
+				break;
+			case M: case SQRT: case SIN: case COS: case TAN:
+			case ASIN: case ACOS: case ATAN:
+				needs = pops = pushes = 1;
+				break;
+			case CLRE:
+				needs = pops = 1;
+				pushes = 0;
+				break;
+			case DOWN: case UP:
+				signature.rotates = true;
+				needs = 1;
+				pops = pushes = 0;
+				break;
+			default:
+				return signature;
+			}
+			lowest = min(lowest, depth - needs);
+			depth += pushes - pops;
+			highest = max(highest, depth);
+		}
+		signature.verified = true;
+		signature.inputs = static_cast<size_t>(-lowest);
+		signature.outputs = static_cast<size_t>(depth - lowest);
+		signature.maxGrowth = static_cast<size_t>(highest);
+		return signature;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			programSignature()
+	//	Description:	Compiles and verifies the program if that has not
+	//						been done since it last changed.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		const StackSignature& -- the program's signature
+	//	Called by:		runProgram(); solve(); stackSignature()
+	//	Calls:			compileProgram(); verifyProgram()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	const StackSignature& CRPNCalc::programSignature()
+	{
+		if (!m_program.compiled())
+			compileProgram();
+		if (!m_program.signature())
+			m_program.setSignature(verifyProgram());
+		return *m_program.signature();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			canRunVerified(const StackSignature& signature)
+	//	Description:	Tells whether the verified program can run without
+	//						checks from the current state: the stack holds
+	//						at least its inputs, and nothing it reads is a
+	//						matrix or complex value.  Complex mode is out
+	//						too, since there SQRT and friends can make
+	//						complex values.  Everything the program makes
+	//						from plain numbers is a plain number, so these
+	//						hold for the whole run.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		const StackSignature& signature -- from
+	//						verifyProgram()
+	//	Returns:		bool -- true if runVerified() may run it
+	//	Called by:		runProgram(); evaluate()
+	//	Calls:			getRegister()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CRPNCalc::canRunVerified(const StackSignature& signature) const
+	{
+		if (!signature.verified || m_complex
+			|| m_stack.size() < signature.inputs)
+			return false;
+		for (size_t i = 0; i < signature.inputs; i++)
+			if (isBoxed(m_stack[i]))
+				return false;
+		if (signature.rotates)			// D and U bring up the bottom
+			for (size_t i = signature.inputs; i < m_stack.size(); i++)
+				if (isBoxed(m_stack[i]))
+					return false;
+		for (int r = 0; r < NUMREGS; r++)
+			if ((signature.registersRead & (1u << r))
+				&& isBoxed(getRegister(r)))
+				return false;
+		if (signature.readsNamed)
+			for (size_t i = 0; i < m_named.size(); i++)
+				if (isBoxed(m_named[i]))
+					return false;
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			runVerified(const StackSignature& signature)
+	//	Description:	Runs a verified program with no per-instruction
+	//						checks: the stack is known to be deep enough
+	//						and to hold only numbers, so each operation
+	//						works on the top entries in place.  The stack
+	//						is grown once for the program's deepest point.
+	//						Errors (divide by zero, 0 ^ 0) behave as in the
+	//						checked commands, which put the operands back;
+	//						that only leaves more entries than the
+	//						signature says, never fewer, so the rest of
+	//						the run stays safe.  The run limits are still
+	//						counted down on every instruction.
+	//	Date:			10/19/2026
+	//	Version:		1.1
+	//	Programmers:	David Landry
+	//	Parameters:		const StackSignature& signature -- from
+	//						verifyProgram(), accepted by canRunVerified()
+	//	Returns:		bool -- true if a line set the error flag
+	//	Called by:		runProgram(); evaluate()
+	//	Calls:			getRegister(); deg2rad(); rad2deg(); stackTouched();
+	//						CRunLimits::exceeded()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//					10/19/2026	DL completed version 1.1, checking
+	//									m_limits.
+	//------------------------------------------------------------------------
+	bool CRPNCalc::runVerified(const StackSignature& signature)
+	{
+		const vector<Instr>& code = m_program.code();
+		CCalcStack& stack = m_stack;
+		bool degrees = (m_trigmode == DEG);
+		bool failed = false;
+		size_t entry = stack.size();
+
+		stack.reserve(signature.maxGrowth);
+		for (size_t i = 0; i < code.size() && code[i].op != STOP; i++)
+		{
+			if (m_limits.exceeded(stack.size()))
+			{
+				failed = true;
+				break;
+			}
+			const Instr& instr = code[i];
+			m_lastCmd = static_cast<cmd>(instr.op);
+			double& top = stack.front();
+			switch (instr.op)
+			{
+			case PUSH:
+				stack.push_front(instr.value);
+				break;
+			case GETN:
+				stack.push_front(m_named[instr.slot]);
+				break;
+			case SETN:
+				m_named[instr.slot] = top;
+				break;
+			case GR0: case GR1: case GR2: case GR3: case GR4:
+			case GR5: case GR6: case GR7: case GR8: case GR9:
+				stack.push_front(getRegister(instr.op - GR0));
+				break;
+			case SR0: case SR1: case SR2: case SR3: case SR4:
+			case SR5: case SR6: case SR7: case SR8: case SR9:
+				setReg(instr.op - SR0);
+				break;
+			case ADD:
+				stack[1] += top;
+				stack.pop_front();
+				break;
+			case SUB:
+				stack[1] -= top;
+				stack.pop_front();
+				break;
+			case MULT:
+				stack[1] *= top;
+				stack.pop_front();
+				break;
+			case DIV:
+				if (top == 0)
+					failed = true;
+				else
+				{
+					stack[1] /= top;
+					stack.pop_front();
+				}
+				break;
+			case EXP:
+				if (top == 0 && stack[1] == 0)
+					failed = true;
+				else
+				{
+					stack[1] = pow(stack[1], top);
+					stack.pop_front();
+				}
+				break;
+			case MOD:
+				stack[1] = fmod(stack[1], top);
+				stack.pop_front();
+				break;
+			case M:
+				top = -top;
+				break;
+			case SQRT:
+				top = sqrt(top);
+				break;
+			case SIN:
+				top = degrees ? sin(deg2rad(top)) : sin(top);
+				break;
+			case COS:
+				top = degrees ? cos(deg2rad(top)) : cos(top);
+				break;
+			case TAN:
+				top = degrees ? tan(deg2rad(top)) : tan(top);
+				break;
+			case ASIN:
+				top = degrees ? rad2deg(asin(top)) : asin(top);
+				break;
+			case ACOS:
+				top = degrees ? rad2deg(acos(top)) : acos(top);
+				break;
+			case ATAN:
+				top = degrees ? rad2deg(atan(top)) : atan(top);
+				break;
+			case CLRE:
+				stack.pop_front();
+				break;
+			case DOWN:
+				rotateDown();
+				break;
+			case UP:
+				rotateUp();
+				break;
+			default:		// NOP
+				break;
+			}
+		}
+		stackTouched(entry - signature.inputs);
+		return failed;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			stackSignature()
+	//	Description:	SIG: pushes the program's stack signature, the
+	//						entries it consumes and then the entries it
+	//						produces in their place, so "2 1" is a program
+	//						that turns two numbers into one.  The error
+	//						flag is set if the program has no fixed
+	//						signature.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			programSignature()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::stackSignature()
+	{
+		const StackSignature& signature = programSignature();
+		if (!signature.verified)
+		{
+			m_error = true;
+			return;
+		}
+		m_stack.push_front(static_cast<double>(signature.inputs));
+		m_stack.push_front(static_cast<double>(signature.outputs));
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,148 @@
+//----------------------------------------------------------------------------
+//    Class:		CFileWatcher
+//
+//    File:       CalcWatch.cpp
+//
+//    Description: This file contains the function definitions for
+//					CFileWatcher
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcWatch.h"
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CFileWatcher()
+	//	Description:	Creates a watcher that is not watching anything.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CFileWatcher::CFileWatcher() : m_fd(-1), m_modified(0), m_size(0),
+		m_watching(false)
+	{
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			~CFileWatcher()
+	//	Description:	Stops watching.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CFileWatcher::~CFileWatcher()
+	{
+		stop();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			watch(const string& fileName)
+	//	Description:	Starts watching a file (and stops watching any
+	//						other).
+	//	Programmers:	David Landry
+	//	Parameters:		const string& fileName -- the file
+	//	Returns:		bool -- false if it cannot be watched
+	//	Called by:		CRPNCalc::cmd_parse()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CFileWatcher::watch(const string& fileName)
+	{
+		struct stat info;
+
+		stop();
+		if (stat(fileName.c_str(), &info) != 0)
+			return false;
+		m_path = fileName;
+		m_modified = info.st_mtime;
+		m_size = static_cast<long long>(info.st_size);
+#ifdef __linux__
+		size_t slash = fileName.rfind('/');
+		string directory = (slash == string::npos) ? "."
+			: fileName.substr(0, slash + 1);
+		m_name = (slash == string::npos) ? fileName
+			: fileName.substr(slash + 1);
+		m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_fd < 0)
+			return false;
+		if (inotify_add_watch(m_fd, directory.c_str(),
+			IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+		{
+			stop();
+			return false;
+		}
+#endif
+		m_watching = true;
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			stop()
+	//	Description:	Stops watching.
+	//	Programmers:	David Landry
+	//	Called by:		watch(); ~CFileWatcher(); CRPNCalc::cmd_parse()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CFileWatcher::stop()
+	{
+#ifdef __linux__
+		if (m_fd >= 0)
+			close(m_fd);
+#endif
+		m_fd = -1;
+		m_watching = false;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			changed()
+	//	Description:	Tells whether the file was rewritten since the last
+	//						call.  Several saves in a row count once.
+	//	Programmers:	David Landry
+	//	Returns:		bool -- true if the file changed
+	//	Called by:		CRPNCalc::reloadIfChanged()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	bool CFileWatcher::changed()
+	{
+		bool seen = false;
+
+		if (!m_watching)
+			return false;
+#ifdef __linux__
+		alignas(inotify_event) char events[4096];
+		long got;
+		while ((got = read(m_fd, events, sizeof(events))) > 0)
+		{
+			for (long at = 0; at < got; )
+			{
+				const inotify_event* event
+					= reinterpret_cast<const inotify_event*>(events + at);
+				if (event->len > 0 && m_name == event->name)
+					seen = true;
+				at += sizeof(inotify_event) + event->len;
+			}
+		}
+#else
+		struct stat info;
+		if (stat(m_path.c_str(), &info) == 0
+			&& (info.st_mtime != m_modified
+				|| static_cast<long long>(info.st_size) != m_size))
+		{
+			m_modified = info.st_mtime;
+			m_size = static_cast<long long>(info.st_size);
+			seen = true;
+		}
+#endif
+		return seen;
+	}
+} // end namespace TPUS_CALC
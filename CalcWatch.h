@@ -0,0 +1,80 @@
+//----------------------------------------------------------------------------
+//    File:		CalcWatch.h
+//
+//    Class:	CFileWatcher
+//----------------------------------------------------------------------------
+#ifndef CALCWATCH_H
+#define CALCWATCH_H
+
+#include <ctime>
+#include <string>
+//----------------------------------------------------------------------------
+//
+//    Title:		CFileWatcher Class
+//
+//    Description:	Tells whether a file has been rewritten since the last
+//						check.  On Linux it uses inotify on the file's
+//						directory, so a file replaced by rename (as most
+//						editors save) is seen as well as one written in
+//						place; only completed writes count, never a file
+//						that is still being written.  The descriptor is
+//						non-blocking, so changed() costs one read(2) that
+//						normally returns nothing.  Elsewhere changed()
+//						compares the file's modification time and size.
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  class CFileWatcher:
+//
+//	  Properties:
+//		int m_fd -- the inotify descriptor (-1 if not watching)
+//		string m_name -- the file's name within its directory
+//		string m_path -- the file as given
+//		time_t m_modified -- modification time at the last check
+//		long long m_size -- size at the last check
+//		bool m_watching -- a file is being watched
+//
+//	  Methods:
+//
+//		inline:
+//			bool isWatching() const
+//
+//		non-inline:
+//			CFileWatcher();
+//			~CFileWatcher();
+//			bool watch(const string& fileName);
+//			void stop();
+//			bool changed();
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	class CFileWatcher
+	{
+	public:
+		CFileWatcher();
+		~CFileWatcher();
+		bool watch(const std::string& fileName);
+		void stop();
+		bool changed();
+		bool isWatching() const { return m_watching; }
+
+	private:
+		CFileWatcher(const CFileWatcher&);				// not copyable
+		CFileWatcher& operator=(const CFileWatcher&);
+
+		int m_fd;
+		std::string m_name;
+		std::string m_path;
+		time_t m_modified;
+		long long m_size;
+		bool m_watching;
+	};
+} // end namespace TPUS_CALC
+
+#endif
@@ -0,0 +1,172 @@
+//----------------------------------------------------------------------------
+//    Class:		CWindow
+//
+//    File:       CalcWindow.cpp
+//
+//    Description: This file contains the function definitions for CWindow
+//
+//    Programmer:		David Landry
+//
+//    Version:          1.0
+//
+//    History Log:
+//						10/19/26 DL completed version 1.0
+// ---------------------------------------------------------------------------
+#include "CalcWindow.h"
+
+using namespace std;
+
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			CWindow()
+	//	Description:	A window with no room; resize() opens it.
+	//	Programmers:	David Landry
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	CWindow::CWindow()
+	{
+		resize(0);
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			resize(size_t capacity)
+	//	Description:	Empties the window and makes room for capacity
+	//						values.
+	//	Programmers:	David Landry
+	//	Parameters:		size_t capacity -- the window's length
+	//	Returns:		None
+	//	Called by:		CRPNCalc::setWindow(); CRPNCalc::loadState()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CWindow::resize(size_t capacity)
+	{
+		m_values.assign(capacity, 0.0);
+		m_pushed = 0;
+		m_count = 0;
+		m_mean = 0.0;
+		m_squares = 0.0;
+		m_evicted = 0;
+		m_low.slots.assign(capacity, 0);
+		m_low.head = m_low.tail = 0;
+		m_high.slots.assign(capacity, 0);
+		m_high.head = m_high.tail = 0;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			push(double value)
+	//	Description:	Adds value to the window, dropping the oldest value
+	//						if it is full.  value must not be NaN.  The
+	//						mean and sum of squares are recomputed early if
+	//						dropping a value cancelled all but CANCEL_LIMIT
+	//						of the sum.
+	//	Programmers:	David Landry
+	//	Parameters:		double value -- the new value
+	//	Returns:		None
+	//	Called by:		CRPNCalc::windowPush(); CRPNCalc::loadState()
+	//	Calls:			recompute()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CWindow::push(double value)
+	{
+		size_t capacity = m_values.size();
+		uint64_t position = m_pushed;
+		bool evicting = (m_count == capacity);
+		bool cancelled = false;
+		double delta;
+
+		if (capacity == 0)
+			return;
+		if (evicting)
+		{
+			double oldest = this->value(position - capacity);
+			if (--m_count == 0)
+				m_mean = m_squares = 0.0;
+			else
+			{
+				double before = m_squares;
+				delta = oldest - m_mean;
+				m_mean -= delta / m_count;
+				m_squares -= delta * (oldest - m_mean);
+				// An outlier leaving takes nearly all of the sum with it,
+				//	and what is left has lost its precision.
+				cancelled = m_squares < before * CANCEL_LIMIT;
+			}
+		}
+		m_values[position % capacity] = value;
+		m_count++;
+		delta = value - m_mean;
+		m_mean += delta / m_count;
+		m_squares += delta * (value - m_mean);
+
+		// Positions before first are out of the window.
+		uint64_t first = position + 1 - m_count;
+		while (!m_low.empty() && m_low.front() < first)
+			m_low.head++;
+		while (!m_low.empty() && this->value(m_low.back()) >= value)
+			m_low.tail--;
+		m_low.slots[m_low.tail++ % capacity] = position;
+		while (!m_high.empty() && m_high.front() < first)
+			m_high.head++;
+		while (!m_high.empty() && this->value(m_high.back()) <= value)
+			m_high.tail--;
+		m_high.slots[m_high.tail++ % capacity] = position;
+
+		m_pushed++;
+		if (evicting && (++m_evicted >= capacity || cancelled))
+			recompute();
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			variance()
+	//	Description:	The sample variance of the values in the window.
+	//	Programmers:	David Landry
+	//	Returns:		double -- the variance; size() must be at least 2
+	//	Called by:		CRPNCalc::windowAggregate()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	double CWindow::variance() const
+	{
+		return (m_squares > 0.0) ? m_squares / (m_count - 1) : 0.0;
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			values(vector<double>& out)
+	//	Description:	Copies the values in the window, oldest first.
+	//	Programmers:	David Landry
+	//	Parameters:		vector<double>& out -- receives the values
+	//	Returns:		None
+	//	Called by:		CRPNCalc::saveState()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CWindow::values(vector<double>& out) const
+	{
+		out.clear();
+		for (uint64_t position = m_pushed - m_count; position < m_pushed;
+			position++)
+			out.push_back(value(position));
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			recompute()
+	//	Description:	Recomputes the mean and the sum of squared
+	//						deviations exactly, in two passes over the ring.
+	//	Programmers:	David Landry
+	//	Returns:		None
+	//	Called by:		push()
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CWindow::recompute()
+	{
+		double sum = 0.0;
+		double squares = 0.0;
+		for (size_t i = 0; i < m_count; i++)
+			sum += m_values[i];
+		double mean = sum / m_count;
+		for (size_t i = 0; i < m_count; i++)
+			squares += (m_values[i] - mean) * (m_values[i] - mean);
+		m_mean = mean;
+		m_squares = squares;
+		m_evicted = 0;
+	}
+} // end namespace TPUS_CALC
@@ -0,0 +1,122 @@
+//----------------------------------------------------------------------------
+//    File:		CalcWindow.h
+//
+//    Class:	CWindow
+//----------------------------------------------------------------------------
+#ifndef CALCWINDOW_H
+#define CALCWINDOW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+//----------------------------------------------------------------------------
+//
+//    Title:		CWindow Class
+//
+//    Description:	A sliding window over the last capacity() values
+//						pushed, with its mean, variance, minimum and
+//						maximum kept up to date in O(1) per push:
+//						-- the values sit in a ring; a push over a full
+//							window overwrites the oldest
+//						-- the mean and the sum of squared deviations are
+//							updated with Welford's method as each value
+//							comes in and goes out; after every
+//							capacity() evictions they are recomputed
+//							exactly from the ring, so rounding cannot
+//							build up over a long stream (O(1) amortized),
+//							and at once when an outlier leaves and takes
+//							nearly all of the sum of squares with it
+//						-- the minimum and maximum come from monotonic
+//							queues of the positions of values that can
+//							still become the minimum (or maximum): each
+//							push drops the entries it beats from the
+//							back and the entry that left the window from
+//							the front, so each position is added and
+//							removed once
+//						Positions are counted from the first push, and a
+//						position's slot in the ring (and in each queue)
+//						is the position modulo capacity().
+//
+//    Programmer:	David Landry
+//
+//    Version:		1.0
+//
+//	  class CWindow:
+//
+//	  Properties:
+//		vector<double> m_values -- the ring
+//		uint64_t m_pushed -- values pushed since the last resize
+//		size_t m_count -- values in the window
+//		double m_mean -- their mean
+//		double m_squares -- their sum of squared deviations from the mean
+//		size_t m_evicted -- evictions since the last exact recompute
+//		MonoQueue m_low, m_high -- the minimum and maximum queues
+//
+//	  Methods:
+//
+//		inline:
+//			size_t capacity() const
+//			size_t size() const
+//			double mean() const
+//			double minimum() const -- size() must be nonzero
+//			double maximum() const -- size() must be nonzero
+//
+//		non-inline:
+//			CWindow();
+//			void resize(size_t capacity);
+//			void push(double value);
+//			double variance() const;
+//			void values(std::vector<double>& out) const;
+//		private:
+//			void recompute();
+//
+//    History Log:
+//			10/19/26 DL completed version 1.0
+// ----------------------------------------------------------------------------
+
+namespace TPUS_CALC
+{
+	class CWindow
+	{
+	public:
+		static constexpr double CANCEL_LIMIT = 1e-4;
+
+		CWindow();
+		void resize(size_t capacity);
+		void push(double value);
+		double variance() const;
+		void values(std::vector<double>& out) const;
+		size_t capacity() const { return m_values.size(); }
+		size_t size() const { return m_count; }
+		double mean() const { return m_mean; }
+		double minimum() const { return value(m_low.front()); }
+		double maximum() const { return value(m_high.front()); }
+
+	private:
+		// A double-ended queue of positions in a ring of capacity() slots.
+		struct MonoQueue
+		{
+			std::vector<uint64_t> slots;
+			uint64_t head;				// positions popped from the front
+			uint64_t tail;				// positions pushed at the back
+			bool empty() const { return head == tail; }
+			uint64_t front() const { return slots[head % slots.size()]; }
+			uint64_t back() const { return slots[(tail - 1) % slots.size()]; }
+		};
+
+		double value(uint64_t position) const
+			{ return m_values[position % m_values.size()]; }
+		void recompute();
+
+		std::vector<double> m_values;
+		uint64_t m_pushed;
+		size_t m_count;
+		double m_mean;
+		double m_squares;
+		size_t m_evicted;
+		MonoQueue m_low;
+		MonoQueue m_high;
+	};
+} // end namespace TPUS_CALC
+
+#endif
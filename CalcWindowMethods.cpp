@@ -0,0 +1,113 @@
+#include "RPNCalc.h"
+namespace TPUS_CALC
+{
+	//------------------------------------------------------------------------
+	//	Method:			setWindow()
+	//	Description:	WIN: "n WIN" opens a sliding window over the last n
+	//						values given to WPUSH, emptying it.  Giving the
+	//						size it already has keeps the values, so a
+	//						program run once per value (a pipeline stage,
+	//						say) can set its window on every run.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			CWindow::resize(); stackTouched()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::setWindow()
+	{
+		double length = m_stack.empty() ? NAN : m_stack.front();
+		if (!(length >= 1 && length <= WINDOW_MAX) || length != floor(length))
+		{
+			m_error = true;
+			return;
+		}
+		m_stack.pop_front();
+		stackTouched(m_stack.size());
+		if (static_cast<size_t>(length) != m_window.capacity())
+			m_window.resize(static_cast<size_t>(length));
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			windowPush()
+	//	Description:	WPUSH: adds the top of the stack to the window,
+	//						dropping the oldest value if it is full.  Like
+	//						S, it leaves the value on the stack.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		None
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			CWindow::push()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::windowPush()
+	{
+		// NaN (and so any matrix or complex value) would break the order
+		//	the minimum and maximum depend on.
+		if (m_stack.empty() || isnan(m_stack.front())
+			|| m_window.capacity() == 0)
+		{
+			m_error = true;
+			return;
+		}
+		m_window.push(m_stack.front());
+	}
+
+	//------------------------------------------------------------------------
+	//	Method:			windowAggregate(cmd thecmd)
+	//	Description:	Pushes a summary of the values in the window: WAVG
+	//						their mean, WMIN and WMAX the least and greatest,
+	//						WSTD their sample standard deviation.  Each is
+	//						kept up to date by CWindow, so none of them
+	//						looks at the values.  The window must not be
+	//						empty, and WSTD needs two values.
+	//	Date:			10/19/2026
+	//	Version:		1.0
+	//	Programmers:	David Landry
+	//	Parameters:		cmd thecmd -- WAVG, WMIN, WMAX or WSTD
+	//	Returns:		None
+	//	Called by:		cmd_parse()
+	//	Calls:			CWindow::mean(); CWindow::minimum();
+	//						CWindow::maximum(); CWindow::variance()
+	//	Input:			None
+	//	Output:			None
+	//	Throws:			None
+	//	Changelog:		10/19/2026	DL completed version 1.0
+	//------------------------------------------------------------------------
+	void CRPNCalc::windowAggregate(cmd thecmd)
+	{
+		double result;
+		if (m_window.size() < ((thecmd == WSTD) ? 2u : 1u))
+		{
+			m_error = true;
+			return;
+		}
+		switch (thecmd)
+		{
+		case WAVG:
+			result = m_window.mean();
+			break;
+		case WMIN:
+			result = m_window.minimum();
+			break;
+		case WMAX:
+			result = m_window.maximum();
+			break;
+		default:
+			result = sqrt(m_window.variance());
+			break;
+		}
+		m_stack.push_front(result);
+	}
+} // end namespace TPUS_CALC
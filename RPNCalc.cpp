@@ -77,10 +77,20 @@ namespace TPUS_CALC
 	//					  6/10/15 TG completed 1.0
 	//-------------------------------------------------------------------------
 	CRPNCalc::CRPNCalc(bool on): m_on(on), m_error(false), m_helpOn(true),
-		m_programRunning(false), m_trigmode(DEG)
+		m_helpPage(0),
+		m_programRunning(false), m_trigmode(DEG), m_lastCmd(NOVAL),
+		m_profileOn(false), m_lowWater(0), m_lineCmd(NOVAL),
+		m_matrixLimit(MATRIX_GC_MIN), m_complexLimit(COMPLEX_GC_MIN),
+		m_complex(false), m_libraryCode(false), m_journalLines(0)
 	{
 		for(int i = 0; i < NUMREGS; i++)
+		{
 			m_registers[i] = 0.0;
+			m_shared[i] = -1;
+		}
+		m_image.registers.reset(
+			new vector<double>(m_registers, m_registers + NUMREGS));
+		m_image.named.reset(new vector<double>());
 		initMap();
 		if(m_on)
 			run();
@@ -94,13 +104,16 @@ namespace TPUS_CALC
 	//	Output		:  to console
 	//	Calls			:	print()
 	//					:	input()
-	//	Called By	:	constructor
+	//	Called By	:	constructor; main()
 	//	Parameters	:	none
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL turns the calculator on, so a
+	//						calculator made off can be set up first
 	//-------------------------------------------------------------------------
 	void CRPNCalc::run()
 	{
+		m_on = ON;
 		while (m_on == ON)
 		{
 			print(cout);
@@ -114,348 +127,135 @@ namespace TPUS_CALC
 	//	Description	:	prints to console:
 	//					:		header 
 	//							top of stack
-	//							help menu if m_helpOn is ture
-	//							<<error>> if m_error; then resets
+	//							help menu page if m_helpOn is ture
+	//							<<error>> if m_error (naming the limit
+	//							if a run hit one); then resets
+	//					:	on an ANSI terminal only the parts of the screen
+	//						that changed are redrawn (see CTermView)
 	//	Input			:     n/a
 	//	Output		:  to console
-	//	Calls			:	empty()
-	//					:	size()
-	//					:	front()
+	//	Calls			:	buildScreen()
+	//					:	CTermView::render()
 	//	Called By	:	run
 	//	Parameters	:	ostream& ostr
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL incremental ANSI rendering instead of
+	//						system("cls") and a full redraw; plain output
+	//						goes to ostr throughout
+	//					  10/19/26 DL the error marker names the limit a
+	//						stopped run hit
 	//-------------------------------------------------------------------------
 	void CRPNCalc::print(ostream& ostr)
 	{
-		double d = 0.0;
-		
-		system("cls");
-
-		ostr << "[RPN Programmable Calculator]" << endl;
-		ostr << "The Puget Unsound -- " 
-					"Thurman Gillespy, David Landry, Jason Gautama" << endl;
-		ostr << "original version by Paul Bladek" << endl;
-		if (m_helpOn)
-			cout << helpMenu;
-		else
-			cout << endl << endl << endl << endl;
-		// status
-		cout << endl;
-		cout << "Stack size: " << m_stack.size() << "  Trig mode: ";
-		cout << ((m_trigmode == RAD) ? "radians" : "degrees") << endl;
-		cout << line;
-		if(!m_stack.empty())
+		if (m_view.isTerminal(ostr))
 		{
-			d = m_stack.front();
-			ostr << d;
+			// Commands that prompt have scrolled the screen.
+			if (promptsUser(m_lineCmd))
+				m_view.invalidate();
+			buildScreen(m_screen);
+			m_view.render(ostr, m_screen);
 		}
-		ostr << endl << endl;
-		if(m_error)
+		else
 		{
-			ostr << "<<error>>" << endl;
-			m_error = false;
+			ostr << "[RPN Programmable Calculator]" << endl;
+			ostr << "The Puget Unsound -- " 
+						"Thurman Gillespy, David Landry, Jason Gautama" << endl;
+			ostr << "original version by Paul Bladek" << endl;
+			if (m_helpOn)
+				ostr << helpMenu[m_helpPage];
+			else
+				ostr << endl << endl << endl << endl;
+			// status
+			ostr << endl;
+			ostr << "Stack size: " << m_stack.size() << "  Trig mode: ";
+			ostr << ((m_trigmode == RAD) ? "radians" : "degrees") << endl;
+			ostr << line;
+			if(!m_stack.empty())
+				printValue(ostr, m_stack.front());
+			ostr << endl << endl;
+			if(m_error)
+				ostr << errorMarker() << endl;
 		}
+		m_error = false;
+		m_limits.clearHit();
 	} 
 
-	//------------------------------------------------------------------------
-	//	Method:			input()
-	//	Description:	Inputs a line from the given stream.
-	//	Date:			6/12/2016
-	//	Version:		1.0
-	//	Programmers:	Thurman Gillespy and David Landry
-	//	Parameters:		istream &instr, a reference to an input stream.
-	//	Returns:		None
-	//	Called by:		run()
-	//	Calls:			parse()
-	//	Input:			A number, constant escape sequence, or command.
-	//	Output:			None
-	//	Throws:			None
-	//	Changelog:		6/6/2016	TG completed version 0.7
-	//					6/7/2016	DL completed version 0.8
-	//					6/11/2016	DL completed version 0.9, adding this
-	//									method header.
-	//					6/12/2016	DL completed version 0.9.5, adding a
-	//									m_instrStream.clear() line to make
-	//									sure the string stream is pure and
-	//									ready for action.
-	//					6/12/2016	DL completed version 1.0
-	//------------------------------------------------------------------------
-	void CRPNCalc::input(istream &instr)
-	{
-		m_instrStream.clear();
-		getline(instr, m_buffer);
-		m_buffer += '\n';
-		m_instrStream.str(m_buffer);
-		parse();
-	}
-
-	//------------------------------------------------------------------------
-	//	Method:			parse()
-	//	Description:	Parses the next command from m_instrStream
-	//	Date:			6/12/2016
-	//	Version:		1.0.1
-	//	Programmers:	Thurman Gillespy and David Landry
-	//	Parameters:		None
-	//	Returns:		None
-	//	Called by:		input()
-	//	Calls:			cmd_parse()
-	//	Input:			None
-	//	Output:			None
-	//	Throws:			None
-	//	Changelog:		6/6/2016	TG completed version 0.6
-	//					6/7/2016	DL completed version 0.7
-	//					6/11/2016	DL completed version 0.8, adding this
-	//									method header.
-	//					6/12/2016	DL	completed version 0.8.5, fixing an
-	//									issue with prefixing a number with
-	//									+ or -.
-	//					6/12/2016	DL	completed version 1.0
-	//					6/12/2016	DL	completed version 1.0.1, fixing a
-	//									bug where entering a decimal without
-	//									a leading 0 would have caused an error
-	//									(e.g., .5 instead of 0.5).
-	//------------------------------------------------------------------------
-	void CRPNCalc::parse()
+	//-------------------------------------------------------------------------
+	//	Class			:	CRPNcalc
+	//	Method		:	buildScreen(vector<string>& rows)
+	//	Description	:	lays out the calculator screen one row per string:
+	//					:		header, HELP_ROWS of help (the current
+	//						page, padded with blank rows, or all blank
+	//						when off, so nothing below it moves), status,
+	//						the top STACK_ROWS stack levels and the error
+	//						marker
+	//	Calls			:	none
+	//	Called By	:	print
+	//	Parameters	:	vector<string>& rows -- receives the rows; reused
+	//						between calls
+	//	History Log	:	
+	//					  10/19/26 DL completed 1.0
+	//					  10/19/26 DL one page of help at a time
+	//-------------------------------------------------------------------------
+	void CRPNCalc::buildScreen(vector<string>& rows)
 	{
-		string	icommand;
-		double	afloat;
+		const char* help = m_helpOn ? helpMenu[m_helpPage] : "";
 		ostringstream oss;
-		char	c = '\0';
-		bool isNegative = false;
-		bool isDecimal = false;
 
-		// input is either a number, a constant or a command
-		// check for a number
-		if (m_buffer == "\n")
-			;
-		else
+		rows.clear();
+		rows.push_back("[RPN Programmable Calculator]");
+		rows.push_back("The Puget Unsound -- "
+			"Thurman Gillespy, David Landry, Jason Gautama");
+		rows.push_back("original version by Paul Bladek");
+		for (unsigned short i = 0; i < HELP_ROWS; i++)
 		{
-			if (m_instrStream.peek() == '-')
-			{
-				m_instrStream.get();
-				if (isdigit(m_instrStream.peek()) || m_instrStream.peek() == '.')
-					isNegative = true;
-				else
-					m_instrStream.putback('-');
-			}
-			if (m_instrStream.peek() == '+')
-			{
-				m_instrStream.get();
-				if (isdigit(m_instrStream.peek()) || m_instrStream.peek() == '.')
-					isNegative = false;
-				else
-					m_instrStream.putback('+');
-			}
-			if (m_instrStream.peek() == '.')
-			{
-				m_instrStream.get();
-				isDecimal = true;
-			}
-			if (isdigit(m_instrStream.peek()))
-			{
-				if (m_instrStream >> afloat)
-				{
-					// Error if anything else in the stream.
-					if (m_instrStream.peek() != '\n')
-						m_error = true;
-					else
-					{
-						afloat = isNegative ? -afloat : afloat;
-						if (isDecimal)
-							while (fabs(afloat) >= 1)
-								afloat /= 10;
-						m_stack.push_front(afloat);
-					}
-				}
-				else
-				{
-					m_error = true;
-				}
-			}
-			// check for constants
-			else if (m_instrStream.peek() == '#')
-			{
-				// remove *
-				m_instrStream.get();
-				c = m_instrStream.get();
-				c = tolower(c);
-				switch (c)
-				{
-				case 'e':
-					if (!m_programRunning)
-						m_stack.push_front(CONST_E);
-					else
-						m_program.push_back("#e");
-					break;
-				case 'p':
-					if (!m_programRunning)
-						m_stack.push_front(CONST_PI);
-					else
-						m_program.push_back("#p");
-					break;
-				case 'c': // speed of light
-					if (!m_programRunning)
-						m_stack.push_front(CONST_C);
-					else
-						m_program.push_back("#c");
-					break;
-				default:
-					m_error = true;
-					break;
-				}
-			}
-			else
+			const char* eol = strchr(help, '\n');
+			rows.push_back(eol ? string(help, eol) : string());
+			if (eol)
+				help = eol + 1;
+		}
+		rows.push_back(string());
+		oss << "Stack size: " << m_stack.size() << "  Trig mode: "
+			<< ((m_trigmode == RAD) ? "radians" : "degrees");
+		rows.push_back(oss.str());
+		rows.push_back(string(line, strlen(line) - 1));
+		for (size_t level = STACK_ROWS; level > 0; level--)
+		{
+			oss.str("");
+			oss << level << ":";
+			if (level <= m_stack.size())
 			{
-				// Call the method to handle commands
-				m_buffer = m_instrStream.str();
-				cmd_parse();
+				oss << "  ";
+				printValue(oss, m_stack[level - 1]);
 			}
+			rows.push_back(oss.str());
 		}
-		m_instrStream.clear();
-		m_instrStream.ignore(BUFFER_SIZE, '\n');
+		rows.push_back(m_error ? errorMarker() : "");
 	}
 
-	//------------------------------------------------------------------------
-	//	Method:			cmd_parse()
-	//	Description:	Handles commands and operators, directing traffic to
-	//						the appropriate methods.
-	//	Date:			6/12/2016
-	//	Version:		1.0
-	//	Programmers:	Thurman Gillespy and David Landry
-	//	Parameters:		None
-	//	Returns:		None
-	//	Called by:		parse()
-	//	Calls:			add(); subtract(); multiply(); divide(); mod(); exp();
-	//					clearEntry(); clearAll();
-	//					rotateDown(); rotateUp();
-	//					saveToFile(); loadProgram();
-	//					recordProgram(); runProgram()
-	//					getReg(); saveReg()
-	//	Input:			None
-	//	Output:			None
-	//	Throws:			None
-	//	Changelog:		6/6/2016	TG completed version 0.6
-	//					6/7/2016	DL completed version 0.7
-	//					6/10/2016	DL completed version 0.8, adding a missing
-	//									command.
-	//					6/11/2016	DL completed version 0.9, adding this
-	//									method header.
-	//					6/12/2016	DL completed version 1.0
-	//------------------------------------------------------------------------
-	void CRPNCalc::cmd_parse()
+	//-------------------------------------------------------------------------
+	//	Class			:	CRPNcalc
+	//	Method		:	promptsUser(cmd thecmd)
+	//	Description	:	tells whether a command writes its own prompts or
+	//						listings to the console
+	//	Calls			:	none
+	//	Called By	:	print
+	//	Parameters	:	cmd thecmd -- the command
+	//	Returns		:	bool - true if the screen needs a full repaint
+	//	History Log	:	
+	//					  10/19/26 DL completed 1.0
+	//-------------------------------------------------------------------------
+	bool CRPNCalc::promptsUser(cmd thecmd) const
 	{
-		string command;
-		char c = ' ';
-		int counter = -1;
-		// Put together the command.
-		while (m_buffer[++counter] != '\n')	// This works for 1 cmd/line
-		{
-			if (isalpha(m_buffer[counter]))
-				command += toupper(m_buffer[counter]);
-			else
-				command += m_buffer[counter];
-		}
-
-		// Find the matching mapped command or write the command to a program
-		//	node.
-		cmd	thecmd = NOVAL;
-		int regVal = -1;
-		map<string, cmd>::iterator it;
-		it = m_map.find(command);
-		if (it != m_map.end())
-			thecmd = it->second;
-		
 		switch (thecmd)
 		{
-		case ADD:
-			add();
-			break;
-		case SUB:
-			subtract();
-			break;
-		case MULT:
-			multiply();
-			break;
-		case DIV:
-			divide();
-			break;
-		case EXP:
-			exp();
-			break;
-		case MOD:
-			mod();
-			break;
-		case CLRE:
-			clearEntry();
-			break;
-		case CLRA:
-			clearAll();
-			break;
-		case DOWN:
-			rotateDown();
-			break;
-		case UP:
-			rotateUp();
-			break;
-		case HELP:
-			m_helpOn = (m_helpOn == true) ? false : true; //toggle help on/off
-			break;
-		case FILE:
-			saveToFile();
-			break;
-		case LOAD:
-			loadProgram();
-			break;
-		case M:
-			neg();
-			break;
-		case TRIGM:
-			m_trigmode = (m_trigmode == RAD) ? DEG : RAD; // toggle trig mode
-			break;
-		case SIN:
-			_sin();
-			break;
-		case ASIN:
-			_asin();
-			break;
-		case COS:
-			_cos();
-			break;
-		case ACOS:
-			_acos();
-			break;
-		case TAN:
-			_tan();
-			break;
-		case ATAN:
-			_atan();
-			break;
-		case SQRT:
-			_sqrt();
-			break;
-		case GR0: case GR1: case GR2: case GR3: case GR4: case GR5:
-		case GR6: case GR7: case GR8: case GR9:
-			regVal = thecmd - GR0;
-			getReg(regVal);
-			break;
-		case SR0: case SR1: case SR2: case SR3: case SR4: case SR5:
-		case SR6: case SR7: case SR8: case SR9:
-			regVal = thecmd - SR0;
-			setReg(regVal);
-			break;
-		case RECORD:
-			recordProgram();
-			break;
-		case RUN:
-			runProgram();
-			break;
-		case EXIT:
-			m_on = OFF;
-			break;
+		case FILE: case LOAD: case RECORD: case TRACEX: case PROFL:
+		case SNAP: case RECALL: case CKPT: case RESUME: case IMP:
+		case LIB:
+			return true;
 		default:
-			m_error = true;
-			break;
+			return false;
 		}
 	}
 
@@ -471,11 +271,15 @@ namespace TPUS_CALC
 	//	Parameters	:     
 	//	History Log	:	
 	//					  6/7/16  JM completed version 1.0
+	//					  10/19/26 DL two matrices go to matrixArith()
+	//					  10/19/26 DL complex operands go to complexArith()
 	//------------------------------------------------------------------------
 	void CRPNCalc::add()
 	{
 		double first = 0;
 		double second = 0;
+		if (matrixArith(ADD) || complexArith(ADD))
+			return;
 		binary_prep(second, first);
 		if (m_error == false)
 			m_stack.push_front(first + second);
@@ -500,16 +304,20 @@ namespace TPUS_CALC
 	//	History Log	:	
 	//					  6/10/16  JM completed version 1.0
 	//					  6/10/16  TG fixed m_stack.size() >= 2
+	//					  10/19/26 DL notes the popped depth for undo
+	//					  10/19/26 DL matrix operands are an error
 	//------------------------------------------------------------------------
 
 	void CRPNCalc::binary_prep(double& d1, double& d2)
 	{
-		if (m_error == false && m_stack.size() >= 2)
+		if (m_error == false && m_stack.size() >= 2
+			&& !isBoxed(m_stack[0]) && !isBoxed(m_stack[1]))
 		{
 			d1 = m_stack.front();
 			m_stack.pop_front();
 			d2 = m_stack.front();
 			m_stack.pop_front();
+			stackTouched(m_stack.size());
 		}
 		else
 			m_error = true;
@@ -526,11 +334,15 @@ namespace TPUS_CALC
 	//	Parameters	:	none
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL notes the popped depth for undo
 	//-------------------------------------------------------------------------
 	void CRPNCalc::clearEntry()
 	{
 		if (!m_stack.empty())
+		{
 			m_stack.pop_front();
+			stackTouched(m_stack.size());
+		}
 	} 
 
 	//-------------------------------------------------------------------------
@@ -543,11 +355,13 @@ namespace TPUS_CALC
 	//	Parameters	:	none
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL notes the cleared stack for undo
 	//-------------------------------------------------------------------------
 	void CRPNCalc::clearAll()
 	{
 		while(!m_stack.empty())	
 			m_stack.pop_front();
+		stackTouched(0);
 	} 
 
 	//------------------------------------------------------------------------
@@ -563,11 +377,16 @@ namespace TPUS_CALC
 	//	History Log	:	
 	//					  6/7/16  JM completed version 1.0
 	//					  6/10/16 JM completed version 1.1
+	//					  10/19/26 DL complex operands go to complexArith()
+	//					  10/19/26 DL keeps binary_prep()'s error (a
+	//						missing or matrix operand) instead of clearing it
 	//------------------------------------------------------------------------
 	void CRPNCalc::divide()
 	{
 		double first = 0;
 		double second = 0;
+		if (complexArith(DIV))
+			return;
 		binary_prep(second, first);
 		if (m_error == false)
 		{
@@ -581,9 +400,6 @@ namespace TPUS_CALC
 			else
 				m_stack.push_front(first / second);
 		}
-		else
-			m_error = false;
-
 	}
 
 	//------------------------------------------------------------------------
@@ -601,11 +417,15 @@ namespace TPUS_CALC
 	//	History Log	:	
 	//					  6/7/16  JM completed version 1.0
 	//					  6/10/16 JM completed version 1.1
+	//					  10/19/26 DL complex operands (or a negative base
+	//								  in complex mode) go to complexArith()
 	//------------------------------------------------------------------------
 	void CRPNCalc::exp()
 	{
 		double first = 0;
 		double second = 0;
+		if (complexArith(EXP))
+			return;
 		binary_prep(second, first);
 		if (m_error == false)
 		{
@@ -629,92 +449,14 @@ namespace TPUS_CALC
 	//	Parameters	:	none
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL reads a mapped register from the
+	//						shared bank
 	//-------------------------------------------------------------------------
 	void CRPNCalc::getReg(int reg)
 	{
-		m_stack.push_front(m_registers[reg]);
+		m_stack.push_front(getRegister(reg));
 	}  
 
-	//------------------------------------------------------------------------
-	//	Method:			loadProgram()
-	//	Description:	Retrieves the filename from the user and loads it into
-	//						m_program
-	//	Date:			6/11/2016
-	//	Version:		0.9
-	//	Programmers:	David Landry
-	//	Parameters:		None
-	//	Returns:		None
-	//	Called by:		cmd_parse()
-	//	Calls:			ofstream::open(); ofstream::close()
-	//	Input:			The filename.
-	//	Output:			A prompt for the filename and various error messages,
-	//						if applicable.  The method also prints the program
-	//						list if the file loads correctly.
-	//	Throws:			File stream error could throw an exception.  This
-	//						method catches any errors thrown by the file
-	//						stream.
-	//	Changelog:		6/10/2016	DL completed version 0.7
-	//					6/10/2016	DL completed version 0.8, correctly
-	//									using the methods of the list class
-	//									(apparently, "m_program[0] =" doesn't
-	//									work) and using a list iterator to
-	//									print the program list upon successful
-	//									retrieval.
-	//					6/11/2016	DL completed version 0.9, adding this
-	//									method header.
-	//------------------------------------------------------------------------
-	void CRPNCalc::loadProgram()
-	{
-		ifstream fileStream;
-		char fileName[BUFFER_SIZE];
-		list<string>::iterator scanProgram;
-		char testChar;
-		string individualCommand;
-		cout << "Please enter a file name to load your program from." << endl;
-		cout << "(The .clc extention will automatically be appended)  ";
-		(cin >> fileName).get();
-		strcat(fileName, ".clc");
-		try
-		{
-			fileStream.open(fileName);
-			if (!fileStream)
-			{
-				cout << "Could not find the indicated file."
-					"  Press \"Enter\" to continue.";
-				fileStream.clear();
-			}
-			else
-			{
-				m_program.clear();
-				while (fileStream.peek() != EOF)
-				{
-					individualCommand += fileStream.get();
-					if (fileStream.peek() == '\n')
-					{
-						individualCommand += fileStream.get();
-						m_program.push_back(individualCommand);
-						individualCommand.clear();
-					}
-				}
-				cout << "Index:\tCommand:\n";
-				unsigned short i = 0;
-				for (scanProgram = m_program.begin();
-					scanProgram != m_program.end(); scanProgram++)
-				{
-					cout << "  " << i++ << "\t" << *scanProgram;
-				}
-				cout << "Press \"Enter\" to continue.";
-			}
-			fileStream.close();
-			cin.get();
-		}
-		catch (exception e)
-		{
-			cout << "Could not open the file.  Press \"Enter\" to continue.";
-			fileStream.clear();
-		}
-	}
-
 	//------------------------------------------------------------------------
 	//	Class		:     void
 	//	Method		:	  mod()
@@ -750,11 +492,15 @@ namespace TPUS_CALC
 	//	Parameters	:     
 	//	History Log	:	
 	//					  6/7/16  JM completed version 1.0
+	//					  10/19/26 DL two matrices go to matrixArith()
+	//					  10/19/26 DL complex operands go to complexArith()
 	//------------------------------------------------------------------------
 	void CRPNCalc::multiply()
 	{
 		double first = 0;
 		double second = 0;
+		if (matrixArith(MULT) || complexArith(MULT))
+			return;
 		binary_prep(second, first);
 		if (m_error == false)
 			m_stack.push_front(first * second);
@@ -772,10 +518,13 @@ namespace TPUS_CALC
 	//	History Log	:	
 	//					  6/9/16  JM completed version 1.0
 	//					  6/10/16 JM completed version 1.1
+	//					  10/19/26 DL complex operand goes to complexFunction()
 	//------------------------------------------------------------------------
 	void CRPNCalc::neg()
 	{
 		double d = 0;
+		if (complexFunction(M))
+			return;
 		unary_prep(d);
 		if (m_error == false)
 		{
@@ -796,100 +545,21 @@ namespace TPUS_CALC
 	//	Parameters	:     double& d -- value reference
 	//	History Log	:	
 	//					  6/10/16  JM completed version 1.0
+	//					  10/19/26 DL notes the popped depth for undo
+	//					  10/19/26 DL a matrix operand is an error
 	//------------------------------------------------------------------------
 	void CRPNCalc::unary_prep(double& d)
 	{
-		if (!m_stack.empty())
+		if (!m_stack.empty() && !isBoxed(m_stack.front()))
 		{
 			d = m_stack.front();
 			m_stack.pop_front();
+			stackTouched(m_stack.size());
 		}
 		else
 			m_error = true;
 	}
 
-	//------------------------------------------------------------------------
-	//	Method:			recordProgram()
-	//	Description:	Takes command-line input and loads it into m_program.
-	//	Date:			6/11/2016
-	//	Version:		0.9
-	//	Programmers:	David Landry
-	//	Parameters:		None
-	//	Returns:		None
-	//	Called by:		cmd_parse()
-	//	Calls:			None
-	//	Input:			Command lines.
-	//	Output:			The line number and a list of commands once recording
-	//						is complete.
-	//	Throws:			None
-	//	Changelog:		6/10/2016	DL completed version 0.6
-	//					6/10/2016	DL completed version 0.7, streamlining
-	//									and consolidating the code.
-	//					6/10/2016	DL completed version 0.8, adding a lot
-	//									of comments to make the code easier
-	//									to follow.
-	//					6/11/2016	DL completed version 0.9, adding this
-	//									method header.
-	//------------------------------------------------------------------------
-	void CRPNCalc::recordProgram()
-	{
-		char choice = ' ';
-		bool isEmpty = false;
-		list<string>::iterator scanProgram = m_program.begin();
-		// Selecting N will clear out m_program before recording a new
-		//	program.  Selecting C will keep m_program as is, allowing the user
-		//	to insert new lines starting at the end of the program.
-		cout << "(N)ew program or (C)ontinue recording?  ";
-		(cin >> choice).get();
-		if (toupper(choice) == 'N')
-			m_program.clear();
-		else if (toupper(choice) == 'C')
-			;
-		else
-			m_error = true;
-		if (!m_error)
-		{
-			cout << "Enter P at any line to view program and exit programming"
-				" mode.\n";
-			// This program uses m_buffer, so clear out any leftover junk.
-			m_buffer.clear();
-			int lineCount = m_program.size() - 1;
-			m_programRunning = true;	// Turns on program recording mode.
-			while (m_programRunning)
-			{
-				cout << ++lineCount << ">";	// Display line number.
-				getline(cin, m_buffer);		// User inputs a line here.
-				m_buffer += '\n';			// Newline separates lines.
-				// If the user entered a P as a line of programming, the
-				//	program will exit program recording mode.  If there is at
-				//	least one program line, it will display the lines of
-				//	programming.  Finally, m_programRunning will be turned
-				//	off (set to false) and the text buffer will be cleared.
-				if (toupper(m_buffer[0]) == 'P')
-				{
-					if (m_program.size() > 0)
-					{
-						cout << "Index:\tCommand:\n";
-						unsigned short i = 0;
-						for (scanProgram = m_program.begin();
-							scanProgram != m_program.end(); scanProgram++)
-						{
-							cout << "  " << i++ << "\t" << *scanProgram;
-						}
-						cout << "Press \"Enter\" to return to the calculator.";
-						cin.get();
-					}
-					m_programRunning = false;
-					m_buffer.clear();
-				}
-				else
-					// As long as any text besides P is entered, the entered
-					//	line of programming gets pushed into m_program.
-					m_program.push_back(m_buffer);
-			}
-		}
-	}
-
 	//------------------------------------------------------------------------
 	//	Class		:     void
 	//	Method		:	  rotateDown()
@@ -901,6 +571,7 @@ namespace TPUS_CALC
 	//	Called By	:     cmd_parse()
 	//	History Log	:	
 	//					  6/11/16 JM completed version 1.0
+	//					  10/19/26 DL notes the rotated stack for undo
 	//------------------------------------------------------------------------
 	void CRPNCalc::rotateDown()
 	{
@@ -911,6 +582,7 @@ namespace TPUS_CALC
 			double lastVal = m_stack.front();
 			m_stack.pop_front();
 			m_stack.push_back(lastVal);
+			stackTouched(0);	// the bottom entry changed
 		}
 	}
 
@@ -925,6 +597,7 @@ namespace TPUS_CALC
 	//	Called By	:     cmd_parse()
 	//	History Log	:	
 	//					  6/11/16 JM completed version 1.0
+	//					  10/19/26 DL notes the rotated stack for undo
 	//------------------------------------------------------------------------
 	void CRPNCalc::rotateUp()
 	{
@@ -935,114 +608,26 @@ namespace TPUS_CALC
 			double lastVal = m_stack.back();
 			m_stack.pop_back();
 			m_stack.push_front(lastVal);
+			stackTouched(0);	// the bottom entry changed
 		}
 	}
 
-	//------------------------------------------------------------------------
-	//	Method:			runProgram()
-	//	Description:	Runs the program in m_program.
-	//	Date:			6/11/2016
-	//	Version:		0.9
-	//	Programmers:	DL
-	//	Parameters:		None
-	//	Returns:		None
-	//	Called by:		cmd_parse()
-	//	Calls:			parse()
-	//	Input:			None
-	//	Output:			None
-	//	Throws:			None
-	//	Changelog:		6/10/2016	DL completed version 0.8.
-	//					6/10/2016	DL completed version 0.8.5, adding an
-	//									important comment.
-	//					6/11/2016	DL completed version 0.9, adding this
-	//									method header.
-	//------------------------------------------------------------------------
-	void CRPNCalc::runProgram()
-	{
-		list<string>::iterator programScanner = m_program.begin();
-		// Run each list element through parse.  Each element should represent
-		//	one line of recorded programming.  Error lines will be processed,
-		//	but will set the error flag, displaying error at the next print
-		//	method call.  However, each line of the program will be run
-		//	regardless.
-		for (; programScanner != m_program.end(); programScanner++)
-		{
-			m_instrStream.str(*programScanner);
-			m_buffer = m_instrStream.str();
-			if (toupper(m_buffer[0]) == 'P')
-				programScanner = --m_program.end();
-			else
-				parse();
-		}
-	}
-
-	//------------------------------------------------------------------------
-	//	Method:			saveToFile()
-	//	Description:	Asks the user for a filename and saves m_program to 
-	//						that file
-	//	Date:			6/11/2016
-	//	Version:		0.9
-	//	Programmers:	David Landry
-	//	Parameters:		None
-	//	Returns:		None
-	//	Called by:		cmd_parse()
-	//	Calls:			ofstream::open(); ofstream::close()
-	//	Input:			The file name.
-	//	Output:			Prompts for the file name and error messages, if
-	//						applicable.
-	//	Throws:			File stream error could throw an exception.  This
-	//						method catches any errors thrown by the file
-	//						stream.
-	//	Changelog:		6/10/2016	DL completed version 0.8.
-	//					6/11/2016	DL completed version 0.9, adding this
-	//									method header.
-	//------------------------------------------------------------------------
-	void CRPNCalc::saveToFile()
-	{
-		ofstream fileStream;
-		char fileName[BUFFER_SIZE];
-		list<string>::iterator programScanner;
-		cout << "Please enter a file name to save your program to." << endl;
-		cout << "(The file will be automatically saved as a .clc file.)  ";
-		(cin >> fileName).get();
-		strcat(fileName, ".clc");
-		try
-		{
-			fileStream.open(fileName);
-			if (!fileStream)
-			{
-				cout << "Could not open the file."
-					"  Press \"Enter\" to continue.";
-				fileStream.clear();
-			}
-			else
-			{
-				for (programScanner = m_program.begin();
-					programScanner != m_program.end(); programScanner++)
-					fileStream << *programScanner;
-				fileStream.close();
-				cout << "Done.  Press \"Enter\" to continue.";
-			}
-			fileStream.close();
-		}
-		catch (exception e)
-		{
-			cout << "Could not open the file.  Press \"Enter\" to continue.";
-			fileStream.clear();
-		}
-		cin.get();
-	}
-
 // ----------------------------------------------------------------------------
 //	gets the value from the top of the stack
 //	  and places it into the given register
+//	  (10/19/26 DL a mapped register is stored to the shared bank, which
+//	  holds numbers only)
 // ----------------------------------------------------------------------------
 	void CRPNCalc::setReg(int reg)
 	{
-		if (!m_stack.empty())
+		if (m_stack.empty())
+			m_error = ON;
+		else if (m_shared[reg] < 0)
 			m_registers[reg] = m_stack.front(); 
-		else
+		else if (isBoxed(m_stack.front()))
 			m_error = ON;
+		else
+			CSharedBank::instance().store(m_shared[reg], m_stack.front());
 	} 
 
 	//------------------------------------------------------------------------
@@ -1057,11 +642,15 @@ namespace TPUS_CALC
 	//	Parameters	:     
 	//	History Log	:	
 	//					  6/7/16  JM completed version 1.0
+	//					  10/19/26 DL two matrices go to matrixArith()
+	//					  10/19/26 DL complex operands go to complexArith()
 	//------------------------------------------------------------------------
 	void CRPNCalc::subtract()
 	{
 		double first = 0;
 		double second = 0;
+		if (matrixArith(SUB) || complexArith(SUB))
+			return;
 		binary_prep(second, first);
 		if (m_error == false)
 			m_stack.push_front(first - second);
@@ -1079,10 +668,14 @@ namespace TPUS_CALC
 	//	Parameters	:	none
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL complex operand (or, in complex mode, an
+	//							  out-of-range one) goes to complexFunction()
 	//-------------------------------------------------------------------------
 	void CRPNCalc::_sqrt()
 	{
 		double d = 0;
+		if (complexFunction(SQRT))
+			return;
 		unary_prep(d);
 		if (m_error == false)
 		{
@@ -1103,10 +696,13 @@ namespace TPUS_CALC
 	//	Parameters	:	none
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL complex operand goes to complexFunction()
 	//-------------------------------------------------------------------------
 	void CRPNCalc::_cos()
 	{
 		double d = 0;
+		if (complexFunction(COS))
+			return;
 
 		unary_prep(d);
 		if (m_error == false)
@@ -1126,10 +722,14 @@ namespace TPUS_CALC
 	//	Parameters	:	none
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL complex operand (or, in complex mode, an
+	//							  out-of-range one) goes to complexFunction()
 	//-------------------------------------------------------------------------
 	void CRPNCalc::_acos()
 	{
 		double d = 0;
+		if (complexFunction(ACOS))
+			return;
 
 		unary_prep(d);
 		if (m_error == false)
@@ -1149,10 +749,13 @@ namespace TPUS_CALC
 	//	Parameters	:	none
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL complex operand goes to complexFunction()
 	//-------------------------------------------------------------------------
 	void CRPNCalc::_sin()
 	{
 		double d = 0;
+		if (complexFunction(SIN))
+			return;
 
 		unary_prep(d);
 		if (m_error == false)
@@ -1172,10 +775,14 @@ namespace TPUS_CALC
 	//	Parameters	:	none
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL complex operand (or, in complex mode, an
+	//							  out-of-range one) goes to complexFunction()
 	//-------------------------------------------------------------------------
 	void CRPNCalc::_asin()
 	{
 		double d = 0;
+		if (complexFunction(ASIN))
+			return;
 
 		unary_prep(d);
 		if (m_error == false)
@@ -1195,10 +802,13 @@ namespace TPUS_CALC
 	//	Parameters	:	none
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL complex operand goes to complexFunction()
 	//-------------------------------------------------------------------------
 	void CRPNCalc::_tan()
 	{
 		double d = 0;
+		if (complexFunction(TAN))
+			return;
 
 		unary_prep(d);
 		if (m_error == false)
@@ -1218,10 +828,13 @@ namespace TPUS_CALC
 	//	Parameters	:	none
 	//	History Log	:	
 	//					  6/10/15 TG completed 1.0
+	//					  10/19/26 DL complex operand goes to complexFunction()
 	//-------------------------------------------------------------------------
 	void CRPNCalc::_atan()
 	{
 		double d = 0;
+		if (complexFunction(ATAN))
+			return;
 
 		unary_prep(d);
 		if (m_error == false)
@@ -1318,6 +931,61 @@ namespace TPUS_CALC
 		m_map.emplace("S7", SR7);
 		m_map.emplace("S8", SR8);
 		m_map.emplace("S9", SR9);
+		m_map.emplace("TRACE", TRACE);
+		m_map.emplace("TX", TRACEX);
+		m_map.emplace("PROF", PROF);
+		m_map.emplace("PL", PROFL);
+		m_map.emplace("UNDO", UNDO);
+		m_map.emplace("REDO", REDO);
+		m_map.emplace("SNAP", SNAP);
+		m_map.emplace("RECALL", RECALL);
+		m_map.emplace("CKPT", CKPT);
+		m_map.emplace("RESUME", RESUME);
+		m_map.emplace("SUM", RSUM);
+		m_map.emplace("MEAN", RMEAN);
+		m_map.emplace("VAR", RVAR);
+		m_map.emplace("MIN", RMIN);
+		m_map.emplace("MAX", RMAX);
+		m_map.emplace("NSUM", NSUM);
+		m_map.emplace("NMEAN", NMEAN);
+		m_map.emplace("NVAR", NVAR);
+		m_map.emplace("NMIN", NMIN);
+		m_map.emplace("NMAX", NMAX);
+		m_map.emplace("DOT", DOT);
+		m_map.emplace("IMP", IMP);
+		m_map.emplace("MAT", MAT);
+		m_map.emplace("MT", MTRANS);
+		m_map.emplace("MSOLVE", MSOLVE);
+		m_map.emplace("MDET", MDET);
+		m_map.emplace("MUNPK", MUNPK);
+		m_map.emplace("CPLX", CPLX);
+		m_map.emplace("J", CJOIN);
+		m_map.emplace("RE", CREAL);
+		m_map.emplace("IM", CIMAG);
+		m_map.emplace("SOLVE", SOLVE);
+		m_map.emplace("INTEG", INTEG);
+		m_map.emplace("DIFF", DIFF);
+		m_map.emplace("GRAD", GRAD);
+		m_map.emplace("W", WATCH);
+		m_map.emplace("LIB", LIB);
+		m_map.emplace("MAP", MAP);
+		m_map.emplace("UNMAP", UNMAP);
+		m_map.emplace("CAS", CAS);
+		m_map.emplace("FADD", FADD);
+		m_map.emplace("SIG", SIG);
+		m_map.emplace("STD", STD);
+		m_map.emplace("FIX", FIX);
+		m_map.emplace("SCI", SCI);
+		m_map.emplace("ENG", ENG);
+		m_map.emplace("WIN", WIN);
+		m_map.emplace("WPUSH", WPUSH);
+		m_map.emplace("WAVG", WAVG);
+		m_map.emplace("WMIN", WMIN);
+		m_map.emplace("WMAX", WMAX);
+		m_map.emplace("WSTD", WSTD);
+		m_map.emplace("LIMI", LIMI);
+		m_map.emplace("LIMS", LIMS);
+		m_map.emplace("LIMT", LIMT);
 	}
 
 	//-------------------------------------------------------------------------
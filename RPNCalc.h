@@ -9,6 +9,8 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <exception>
 #include <fstream>
 #include <iostream>
@@ -19,6 +21,27 @@
 #include <sstream>
 #include <stack>
 #include <map>
+#include "CalcBlockReader.h"
+#include "CalcComplex.h"
+#include "CalcDual.h"
+#include "CalcFormat.h"
+#include "CalcJournal.h"
+#include "CalcLibrary.h"
+#include "CalcLimits.h"
+#include "CalcMatrix.h"
+#include "CalcNames.h"
+#include "CalcPipe.h"
+#include "CalcProgram.h"
+#include "CalcRecorder.h"
+#include "CalcReduce.h"
+#include "CalcResultSink.h"
+#include "CalcShared.h"
+#include "CalcStack.h"
+#include "CalcTermView.h"
+#include "CalcTrace.h"
+#include "CalcUndo.h"
+#include "CalcWatch.h"
+#include "CalcWindow.h"
 //----------------------------------------------------------------------------
 //
 //    Title:		RPNCalc Class
@@ -42,20 +65,57 @@
 //	  Properties:
 //		double m_registers[10] -- registers 0 - 9
 //		string m_buffer -- used in handling input
-//		stack<string> m_stack -- calculator numbers added and removed as needed
-//		list<string> m_program  --  the current program
-//		istringstream m_inStrStream -- for handling input
+//		CCalcStack m_stack -- calculator numbers added and removed as needed
+//		CProgram m_program  --  the current program: text and compiled code
 //		m_on -- determines when program is to quit
 //		bool m_error -- error flag; cleared by print
 //		bool m_helpOn --  if true, help menu displayed
+//		unsigned short m_helpPage -- the page of it displayed
 //		bool m_programRunning -- program mode is on, recroding commands
 //		RPNmap m_map -- map<string, cmd> - maps command line string to an enum
 //		trigmode m_trigmode -- radians vs degrees 
+//		CTraceBuffer m_trace -- execution trace of program runs
+//		cmd m_lastCmd -- command executed by the most recent parse()
+//		bool m_profileOn -- if true, runProgram() profiles each line
+//		vector<ProfileEntry> m_profile -- per-line counts and cycles
+//		CSnapshot m_image -- persistent image of the latest undo point
+//		size_t m_lowWater -- lowest stack depth touched since m_image
+//		deque<CSnapshot> m_undo -- undo points, oldest first
+//		vector<CSnapshot> m_redo -- states undone, most recent last
+//		map<string, CSnapshot> m_snapshots -- named snapshots
+//		CTermView m_view -- what is on the terminal
+//		vector<string> m_screen -- screen rows, reused by print()
+//		cmd m_lineCmd -- command on the last input line
+//		CNameTable m_names -- named register names and their slots
+//		vector<double> m_named -- named register values, by slot
+//		CMatrixTable m_matrices -- the matrices stack values refer to
+//		size_t m_matrixLimit -- live matrices before the next collection
+//		CComplexTable m_complexes -- the complex values stack values refer to
+//		size_t m_complexLimit -- live complex values before the next
+//			collection
+//		bool m_complex -- complex mode: out-of-domain results are complex
+//		CCalcStack m_scratch -- the stack SOLVE and INTEG evaluate f on
+//		string m_programFile -- the file the program was loaded from
+//		CFileWatcher m_watcher -- watches m_programFile for W
+//		CLibrary m_library -- the program library open for L:name
+//		bool m_libraryCode -- m_library's code fits this command set
+//		CNameTable m_programNames -- program names used with L:name
+//		CJournal m_journal -- the session journal, if journaling
+//		string m_journalBase -- its file names, without the extension
+//		size_t m_journalLines -- lines journaled since the last compaction
+//		int m_shared[NUMREGS] -- shared bank slot of each register (-1 if
+//			private)
+//		CNumberFormat m_format -- how numbers are displayed
+//		CWindow m_window -- the sliding window for WPUSH, WAVG and so on
+//		CRunLimits m_limits -- instruction, stack and time limits on
+//			running a program
 //		
 //
 //	  Methods:
 //	
-//		inline:	None		
+//		inline:
+//			void stackTouched(size_t depth)
+//			void markValue(double value)
 //
 //		non-inline:
 //		public:
@@ -63,13 +123,29 @@
 //			void run();                                        
 //			void print(ostream& ostr);
 //			void input(istream& istr);
+//			bool saveState(const char* fileName);
+//			bool loadState(const char* fileName);
+//			void runBatch(CBlockReader& reader, ostream& ostr,
+//				CResultSink* sink);
+//			bool importFile(const char* fileName, bool binary);
+//			bool packLibrary(const char* archive, int count, char* files[],
+//				ostream& log);
+//			bool openLibrary(const char* fileName);
+//			bool openJournal(const char* baseName);
+//			static bool runPipeline(int count, char* programs[],
+//				CBlockReader& reader, ostream& ostr, ostream& log);
+//			void replaySession(const vector<TraceLine>& lines, bool paced,
+//				ostream& report);
 //		private:
 //				
 //			void add() -- 
 //			void bin_prep(double& d1, double& d2) -- 
 //			void clearEntry() -- 
 //			void clearAll() -- 
-//			void cmd_parse() --
+//			void cmd_parse(cmd thecmd) --
+//			void compileProgram() --
+//			Instr compileLine(const char* text, size_t len, int line) --
+//			void execute(const Instr& instr) --
 //			void divide() -- 
 //			void exp() -- 
 //			void getReg(int reg) -- 
@@ -77,7 +153,7 @@
 //			void mod() -- 
 //			void multiply() -- 
 //			void neg() -- 
-//			void parse() -- 
+//			cmd parse() -- 
 //			void recordProgram() -- 
 //			void rotateUp() -- 
 //			void rotateDown() -- 
@@ -95,6 +171,69 @@
 //			void _atan();
 //			double deg2rad(double deg);
 //			double rad2deg(double rad);
+//			void exportTrace();
+//			void printProfile();
+//			void runInstrumented(const Instr& instr);
+//			CSnapshot snapshot();
+//			void restore(const CSnapshot& image);
+//			bool stateChanged(const CSnapshot& before) const;
+//			void undo();
+//			void redo();
+//			void saveSnapshot();
+//			void recallSnapshot();
+//			void checkpoint();
+//			void resume();
+//			void buildScreen(vector<string>& rows);
+//			bool promptsUser(cmd thecmd) const;
+//			void reduce(cmd thecmd);
+//			void importData();
+//			void makeMatrix();
+//			void unpackMatrix();
+//			void matrixOp(cmd thecmd);
+//			bool matrixArith(cmd thecmd);
+//			void pushMatrix(CMatrix& matrix);
+//			void collectValues();
+//			void markSnapshot(const CSnapshot& image);
+//			void printValue(ostream& ostr, double value) const;
+//			void makeComplex();
+//			void complexPart(cmd thecmd);
+//			bool complexOperand(double value, double& re, double& im) const;
+//			bool complexArith(cmd thecmd);
+//			bool complexFunction(cmd thecmd);
+//			void pushComplex(double re, double im);
+//			void solve(cmd thecmd);
+//			bool canEvaluate() const;
+//			bool evaluate(double x, double& fx);
+//			void differentiate(cmd thecmd);
+//			bool runDual(CDualStack& stack);
+//			void watchProgram();
+//			void reloadIfChanged();
+//			void reloadProgram();
+//			void loadLibrary();
+//			void loadFromLibrary(int slot);
+//			uint32_t commandTableHash() const;
+//			void journalLine();
+//			bool replayable(cmd thecmd) const;
+//			bool compactJournal();
+//			double getRegister(int reg) const;
+//			void registerValues(double* values) const;
+//			void mapRegister();
+//			void unmapRegister();
+//			void sharedOp(cmd thecmd);
+//			StackSignature verifyProgram() const;
+//			const StackSignature& programSignature();
+//			bool canRunVerified(const StackSignature& signature) const;
+//			bool runVerified(const StackSignature& signature);
+//			void stackSignature();
+//			void setFormat(cmd thecmd);
+//			void runStage(CPipeQueue& input, CPipeQueue& output,
+//				PipeStats& stats);
+//			int stageBlocker() const;
+//			void setWindow();
+//			void windowPush();
+//			void windowAggregate(cmd thecmd);
+//			void setLimit(cmd thecmd);
+//			const char* errorMarker() const;
 //
 //    History Log:
 //	4/20/03	PB  completed version 1.0
@@ -110,6 +249,57 @@
 //			6/12/16 deg2rad added; full trig support
 //			6/12/16 rad2deg added for inverse trig; final headers and bug fixes
 //			6/12/16 - version 1.1 by TG
+//			10/19/26 DL added program execution tracing (TRACE, TX)
+//			10/19/26 DL added the hot-line profiler (PROF, PL)
+//			10/19/26 DL m_program is now an arena-backed CProgram that is
+//				compiled once and run from its instructions
+//			10/19/26 DL added multi-level undo/redo and named snapshots
+//				(UNDO, REDO, SNAP, RECALL) on a persistent stack image
+//			10/19/26 DL added checkpoint/restore of the full state to a
+//				versioned binary image (CKPT, RESUME)
+//			10/19/26 DL print() renders incrementally with ANSI escapes
+//				and shows STACK_ROWS stack levels
+//			10/19/26 DL added runBatch() for piped workloads read in blocks
+//			10/19/26 DL added any number of named registers (G:name,
+//				S:name), resolved to slots when a line is compiled
+//			10/19/26 DL m_stack is a contiguous CCalcStack; added the
+//				stack reductions (SUM, MEAN, VAR, MIN, MAX, NSUM..NMAX, DOT)
+//			10/19/26 DL added bulk import of numeric files (IMP, importFile)
+//			10/19/26 DL runBatch() can write its results to a columnar
+//				binary CResultSink
+//			10/19/26 DL added matrix values (MAT, MUNPK, MT, MDET, MSOLVE);
+//				+, - and * work on two matrices
+//			10/19/26 DL added complex values and complex mode (CPLX, J, RE,
+//				IM); arithmetic, SQRT and the trig commands take them
+//			10/19/26 DL the help menu is HELP_PAGES pages; H steps through
+//				them, then turns help off
+//			10/19/26 DL added SOLVE and INTEG over the compiled program
+//			10/19/26 DL added forward-mode differentiation of the program
+//				(DIFF, GRAD)
+//			10/19/26 DL added W: reload the program file when it changes,
+//				recompiling only the changed lines
+//			10/19/26 DL added program library archives: LIB opens one,
+//				L:name loads a program from it (packLibrary, openLibrary)
+//			10/19/26 DL added the session journal with group commit,
+//				replay and compaction (openJournal, rpncalc -j)
+//			10/19/26 DL registers can be mapped to the process's lock-free
+//				shared bank (MAP, UNMAP); added CAS and FADD
+//			10/19/26 DL programs with a fixed stack effect are verified
+//				once and run without per-line checks; SIG shows the effect
+//			10/19/26 DL numbers are displayed through CNumberFormat: STD
+//				(shortest exact form, the default), n FIX, n SCI, n ENG
+//			10/19/26 DL added pipelines of programs, each stage on its own
+//				thread (runPipeline, rpncalc -p)
+//			10/19/26 DL a pipeline stage may not prompt, exit or load from
+//				the library (stageBlocker)
+//			10/19/26 DL added a sliding window with O(1) updates: WIN,
+//				WPUSH, WAVG, WMIN, WMAX, WSTD
+//			10/19/26 DL added session recording and replay with per-command
+//				latencies (replaySession, rpncalc -rec, rpncalc -replay)
+//			10/19/26 DL added instruction, stack and time limits on program
+//				runs: LIMI, LIMS, LIMT
+//			10/19/26 DL #e and #p carry full double precision, now that STD
+//				shows every digit
 // ----------------------------------------------------------------------------
 
 using namespace std;
@@ -117,11 +307,34 @@ using namespace std;
 namespace TPUS_CALC
 {
 
-	const char helpMenu[] =
+	// The help menu, a page at a time (H shows the next page, then none),
+	//	so the screen fits a 24-row terminal.
+	const unsigned short HELP_PAGES = 3;
+	const unsigned short HELP_ROWS = 7;		// lines on each page
+	const char* const helpMenu[HELP_PAGES] = {
 	"C clear stack   | CE clear entry  | D rotate down  | F save program to file\n"
-	"G0-G9 get reg n | H help on/off   | L load program | M +/-  | P program on/off\n"
+	"G0-G9 get reg n | H next help/off | L load program | M +/-  | P program on/off\n"
 	"R run program   | S0-S9 set reg n | U rotate up    | X exit | T toggle rad/deg\n"
-	"Constants: #e e, #p pi, #c c      | Trig: cos, sin, tan, acos, asin, atan\n";
+	"Constants: #e e, #p pi, #c c      | Trig: cos, sin, tan, acos, asin, atan\n"
+	"TRACE trace runs on/off | TX export trace | PROF profile on/off | PL listing\n"
+	"UNDO | REDO | SNAP save named snapshot | RECALL restore named snapshot\n"
+	"CKPT save calculator state | RESUME restore calculator state\n",
+
+	"G:name get named register  | S:name set named register\n"
+	"SUM MEAN VAR MIN MAX of the stack | NSUM..NMAX of top n | n DOT\n"
+	"IMP import a file of numbers (text, or raw doubles if .bin)\n"
+	"r*c values r c MAT | MUNPK | MT transpose | MDET | A b MSOLVE | + - *\n"
+	"CPLX complex mode on/off | re im J make complex | RE, IM parts\n"
+	"a b SOLVE root, a b INTEG integral of the program as f(x), x in R0\n"
+	"DIFF f and df/dR0 | n GRAD f and df/dR0..df/dR(n-1) of the program\n",
+
+	"W watch the loaded program file on/off (reload it when it is saved)\n"
+	"LIB open a program library | L:name load a program from the library\n"
+	"r s MAP share reg r as slot s | r UNMAP | old new r CAS | x r FADD\n"
+	"SIG the program's stack signature: entries consumed, entries produced\n"
+	"STD shortest exact display | n FIX | n SCI | n ENG show n places\n"
+	"n WIN window of last n | WPUSH add top | WAVG WMIN WMAX WSTD of window\n"
+	"n LIMI instructions | n LIMS stack depth | n LIMT ms a run may use\n" };
 
 	const char line[] = "______________________________"
 								"______________________________________________\n";
@@ -130,8 +343,14 @@ namespace TPUS_CALC
 	const bool ON = true;
 	const bool OFF = false;
 	const short BUFFER_SIZE = 256;
-	const double CONST_E = 2.7182818;
-	const double CONST_PI = 3.14159265;
+	const unsigned short MAXUNDO = 100;
+	const unsigned short STACK_ROWS = 4;	// stack levels on screen
+	const size_t MATRIX_GC_MIN = 64;	// matrices before the first collection
+	const size_t COMPLEX_GC_MIN = 1024;	// the same for complex values
+	const size_t JOURNAL_COMPACT_LINES = 1000;	// journal lines per snapshot
+	const size_t WINDOW_MAX = 1 << 24;	// the longest sliding window
+	const double CONST_E = 2.718281828459045;
+	const double CONST_PI = 3.141592653589793;
 	const double CONST_C = 299792458;
 
 	typedef enum trigmode { RAD, DEG };
@@ -141,7 +360,15 @@ namespace TPUS_CALC
 		FILE, HELP, LOAD, M, RECORD, RUN, TRIGM, EXIT, SQRT,
 		COS, ACOS, SIN, ASIN, TAN, ATAN,
 		GR0, GR1, GR2, GR3, GR4, GR5, GR6, GR7, GR8, GR9,
-		SR0, SR1, SR2, SR3, SR4, SR5, SR6, SR7, SR8, SR9
+		SR0, SR1, SR2, SR3, SR4, SR5, SR6, SR7, SR8, SR9,
+		PUSH, NOP, STOP, TRACE, TRACEX, PROF, PROFL,
+		UNDO, REDO, SNAP, RECALL, CKPT, RESUME, GETN, SETN,
+		RSUM, RMEAN, RVAR, RMIN, RMAX, NSUM, NMEAN, NVAR, NMIN, NMAX, DOT,
+		IMP, MAT, MTRANS, MSOLVE, MDET, MUNPK, CPLX, CJOIN, CREAL, CIMAG,
+		SOLVE, INTEG, DIFF, GRAD, WATCH, LIB, LOADN, MAP, UNMAP, CAS, FADD,
+		SIG, STD, FIX, SCI, ENG, WIN, WPUSH, WAVG, WMIN, WMAX, WSTD,
+		LIMI, LIMS, LIMT,
+		NUMCMDS
 	};
 
 	typedef map<string, cmd> RPNmap;
@@ -153,6 +380,19 @@ namespace TPUS_CALC
 		void run();                                        
 		void print(ostream& ostr);  // changes m_error on error, so not const
 		void input(istream& istr);
+		bool saveState(const char* fileName);
+		bool loadState(const char* fileName);
+		void runBatch(CBlockReader& reader, ostream& ostr,
+			CResultSink* sink = 0);
+		bool importFile(const char* fileName, bool binary);
+		bool packLibrary(const char* archive, int count, char* files[],
+			ostream& log);
+		bool openLibrary(const char* fileName);
+		bool openJournal(const char* baseName);
+		static bool runPipeline(int count, char* programs[],
+			CBlockReader& reader, ostream& ostr, ostream& log);
+		void replaySession(const vector<TraceLine>& lines, bool paced,
+			ostream& report);
 
 	private:
 	// private methods
@@ -160,7 +400,10 @@ namespace TPUS_CALC
 		void binary_prep(double& d1, double& d2);
 		void clearEntry();
 		void clearAll();
-		void cmd_parse();
+		void cmd_parse(cmd thecmd);
+		void compileProgram();
+		Instr compileLine(const char* text, size_t len, int line);
+		void execute(const Instr& instr);
 		void divide();
 		void exp();
 		void getReg(int reg);
@@ -168,7 +411,7 @@ namespace TPUS_CALC
 		void mod();
 		void multiply();
 		void neg();
-		void parse(); 
+		cmd parse();
 		void recordProgram();
 		void rotateUp();
 		void rotateDown();
@@ -187,19 +430,121 @@ namespace TPUS_CALC
 		void _atan();
 		double deg2rad(double deg);
 		double rad2deg(double rad);
+		void exportTrace();
+		void printProfile();
+		void runInstrumented(const Instr& instr);
+		CSnapshot snapshot();
+		void restore(const CSnapshot& image);
+		bool stateChanged(const CSnapshot& before) const;
+		void undo();
+		void redo();
+		void saveSnapshot();
+		void recallSnapshot();
+		void checkpoint();
+		void resume();
+		void buildScreen(vector<string>& rows);
+		bool promptsUser(cmd thecmd) const;
+		void reduce(cmd thecmd);
+		void importData();
+		void makeMatrix();
+		void unpackMatrix();
+		void matrixOp(cmd thecmd);
+		bool matrixArith(cmd thecmd);
+		void pushMatrix(CMatrix& matrix);
+		void collectValues();
+		void markSnapshot(const CSnapshot& image);
+		void printValue(ostream& ostr, double value) const;
+		void makeComplex();
+		void complexPart(cmd thecmd);
+		bool complexOperand(double value, double& re, double& im) const;
+		bool complexArith(cmd thecmd);
+		bool complexFunction(cmd thecmd);
+		void pushComplex(double re, double im);
+		void solve(cmd thecmd);
+		bool canEvaluate() const;
+		bool evaluate(double x, double& fx);
+		void differentiate(cmd thecmd);
+		bool runDual(CDualStack& stack);
+		void watchProgram();
+		void reloadIfChanged();
+		void reloadProgram();
+		void loadLibrary();
+		void loadFromLibrary(int slot);
+		uint32_t commandTableHash() const;
+		void journalLine();
+		bool replayable(cmd thecmd) const;
+		bool compactJournal();
+		double getRegister(int reg) const;
+		void registerValues(double* values) const;
+		void mapRegister();
+		void unmapRegister();
+		void sharedOp(cmd thecmd);
+		StackSignature verifyProgram() const;
+		const StackSignature& programSignature();
+		bool canRunVerified(const StackSignature& signature) const;
+		bool runVerified(const StackSignature& signature);
+		void stackSignature();
+		void setFormat(cmd thecmd);
+		void runStage(CPipeQueue& input, CPipeQueue& output,
+			PipeStats& stats);
+		int stageBlocker() const;
+		void setWindow();
+		void windowPush();
+		void windowAggregate(cmd thecmd);
+		void setLimit(cmd thecmd);
+		const char* errorMarker() const;
+		// Marks a boxed value as reachable for collectValues().
+		void markValue(double value)
+			{ m_matrices.mark(value); m_complexes.mark(value); }
+		// Records that the stack was popped (or rewritten) down to depth,
+		//	so the next snapshot() knows how much of m_image is still valid.
+		void stackTouched(size_t depth)
+			{ if (depth < m_lowWater) m_lowWater = depth; }
 
 	// private properties
 		double m_registers[NUMREGS];
 		string m_buffer;
-		deque<double> m_stack;
-		list<string> m_program;
-		istringstream m_instrStream;
+		CCalcStack m_stack;
+		CProgram m_program;
 		bool m_error;
 		bool m_helpOn;
+		unsigned short m_helpPage;
 		bool m_on;
 		bool m_programRunning;
 		RPNmap m_map;
 		trigmode m_trigmode;
+		CTraceBuffer m_trace;
+		cmd m_lastCmd;
+		bool m_profileOn;
+		vector<ProfileEntry> m_profile;
+		CSnapshot m_image;
+		size_t m_lowWater;
+		deque<CSnapshot> m_undo;
+		vector<CSnapshot> m_redo;
+		map<string, CSnapshot> m_snapshots;
+		CTermView m_view;
+		vector<string> m_screen;
+		cmd m_lineCmd;
+		CNameTable m_names;
+		vector<double> m_named;
+		CMatrixTable m_matrices;
+		size_t m_matrixLimit;
+		CComplexTable m_complexes;
+		size_t m_complexLimit;
+		bool m_complex;
+		CCalcStack m_scratch;
+		string m_programFile;
+		CFileWatcher m_watcher;
+		CLibrary m_library;
+		bool m_libraryCode;
+		CNameTable m_programNames;
+		CJournal m_journal;
+		string m_journalBase;
+		size_t m_journalLines;
+		int m_shared[NUMREGS];
+		CNumberFormat m_format;
+		CWindow m_window;
+		CRunLimits m_limits;
 	};
 
 	ostream &operator <<(ostream &ostr, CRPNCalc &calc);